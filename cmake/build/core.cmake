@@ -0,0 +1,18 @@
+## the headless game core library
+## it must not depend on ASGE so it can be linked by headless tools
+
+target_include_directories(
+        GameCore
+        PUBLIC
+        "${CMAKE_CURRENT_SOURCE_DIR}")
+
+target_compile_options(
+        GameCore PRIVATE
+        $<$<COMPILE_LANGUAGE:CXX>:${BUILD_FLAGS_FOR_CXX}>)
+
+if(CMAKE_COMPILER_IS_GNUCC)
+    target_link_libraries(GameCore PUBLIC pthread)
+endif()
+
+## the core parses the game data, json must already be included
+target_link_libraries(GameCore PUBLIC jsonlib)
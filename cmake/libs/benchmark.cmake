@@ -0,0 +1,27 @@
+## Google Benchmark, used by the core benchmarks
+## prefers an installed copy and fetches one otherwise
+
+if (NOT TARGET benchmark::benchmark)
+    find_package(benchmark QUIET)
+endif()
+
+if (NOT benchmark_FOUND AND NOT TARGET benchmark::benchmark)
+
+    # fetch project
+    include(FetchContent)
+    FetchContent_Declare(
+            benchmark
+            GIT_REPOSITORY https://github.com/google/benchmark.git
+            GIT_TAG        v1.5.0)
+
+    FetchContent_GetProperties(benchmark)
+    if(NOT benchmark_POPULATED)
+        FetchContent_Populate(benchmark)
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE INTERNAL "OFF")
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE INTERNAL "OFF")
+        add_subdirectory(${benchmark_SOURCE_DIR} ${benchmark_BINARY_DIR})
+    endif()
+endif()
+
+# link the project calling this script
+target_link_libraries(${PROJECT_NAME} benchmark::benchmark)
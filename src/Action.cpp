@@ -24,32 +24,32 @@ void Action::setup(int id,
   response = output;
 }
 
-int Action::actionID()
+int Action::actionID() const
 {
   return ID;
 }
 
-std::string Action::actionVerb()
+const std::string& Action::actionVerb() const
 {
   return verb;
 }
 
-int Action::actionObject()
+int Action::actionObject() const
 {
   return object;
 }
 
-int* Action::objectsNeeded()
+const int* Action::objectsNeeded() const
 {
   return objects_needed;
 }
 
-int Action::requiredRoom()
+int Action::requiredRoom() const
 {
   return room;
 }
 
-std::string Action::output()
+const std::string& Action::output() const
 {
   return response;
 }
@@ -20,12 +20,12 @@ class Action
              int required_room,
              std::string output);
 
-  int actionID();
-  std::string actionVerb();
-  int actionObject();
-  int* objectsNeeded();
-  int requiredRoom();
-  std::string output();
+  int actionID() const;
+  const std::string& actionVerb() const;
+  int actionObject() const;
+  const int* objectsNeeded() const;
+  int requiredRoom() const;
+  const std::string& output() const;
 
  private:
   int ID;
@@ -36,7 +36,7 @@ int Input::menuOption(int key, int action, int* menu_option, int num_options)
   }
 }
 
-std::string Input::input()
+const std::string& Input::input() const
 {
   return current_input;
 }
@@ -23,7 +23,7 @@ class Input
 
   int menuOption(int key, int action, int* menu_option, int num_options);
 
-  std::string input();
+  const std::string& input() const;
   void input(const std::string* input);
 
  private:
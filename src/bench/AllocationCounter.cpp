@@ -0,0 +1,85 @@
+//
+// Created by Zoe on 09/11/2019.
+//
+
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<uint64_t> allocations{ 0 };
+std::atomic<uint64_t> live_bytes{ 0 };
+std::atomic<uint64_t> peak_bytes{ 0 };
+
+/** Every allocation starts with its size, padded to keep the alignment. */
+const std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void updatePeak(uint64_t live)
+{
+  uint64_t peak = peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !peak_bytes.compare_exchange_weak(
+           peak, live, std::memory_order_relaxed))
+  {
+  }
+}
+}
+
+uint64_t BENCH::allocationCount()
+{
+  return allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ *   @brief   The number of bytes allocated and not yet freed
+ */
+uint64_t BENCH::liveBytes()
+{
+  return live_bytes.load(std::memory_order_relaxed);
+}
+
+/**
+ *   @brief   The most bytes held at once since resetPeak()
+ */
+uint64_t BENCH::peakBytes()
+{
+  return peak_bytes.load(std::memory_order_relaxed);
+}
+
+void BENCH::resetPeak()
+{
+  peak_bytes.store(liveBytes(), std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(HEADER_SIZE + size))
+  {
+    *static_cast<std::size_t*>(memory) = size;
+    updatePeak(live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+    return static_cast<char*>(memory) + HEADER_SIZE;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+  if (memory == nullptr)
+  {
+    return;
+  }
+
+  void* block = static_cast<char*>(memory) - HEADER_SIZE;
+  live_bytes.fetch_sub(*static_cast<std::size_t*>(block),
+                       std::memory_order_relaxed);
+  std::free(block);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+  operator delete(memory);
+}
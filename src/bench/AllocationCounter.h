@@ -0,0 +1,23 @@
+//
+// Created by Zoe on 09/11/2019.
+//
+
+#ifndef PROJECT_ALLOCATIONCOUNTER_H
+#define PROJECT_ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+/**
+ *  Counts every heap allocation made by the benchmark process, the
+ *  bytes still held and the most bytes held at once. The global
+ *  operator new is replaced in AllocationCounter.cpp.
+ */
+namespace BENCH
+{
+uint64_t allocationCount();
+uint64_t liveBytes();
+uint64_t peakBytes();
+void resetPeak();
+}
+
+#endif // PROJECT_ALLOCATIONCOUNTER_H
@@ -0,0 +1,70 @@
+//
+// Created by Zoe on 09/11/2019.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.h"
+#include "game/GameScreen.h"
+#include "session/DataReader.h"
+#include "session/GameSession.h"
+
+namespace
+{
+void reportAllocations(benchmark::State& state, uint64_t since)
+{
+  state.counters["allocs_per_frame"] = benchmark::Counter(
+    static_cast<double>(BENCH::allocationCount() - since),
+    benchmark::Counter::kAvgIterations);
+}
+}
+
+/**
+ *   @brief   A game screen frame where nothing has changed
+ *   @details The usual case, the player is reading or thinking.
+ */
+static void BM_GameScreenIdleFrame(benchmark::State& state)
+{
+  GameSession session(DATA::diskReader(GAMEDATA_PATH));
+  session.load();
+  session.reset();
+  session.step("N");
+
+  GameScreen game_screen;
+  game_screen.input("GET CAND");
+  game_screen.update(session);
+
+  uint64_t allocations = BENCH::allocationCount();
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(game_screen.update(session));
+  }
+  reportAllocations(state, allocations);
+}
+BENCHMARK(BM_GameScreenIdleFrame)->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   A game screen frame where every line is rebuilt
+ *   @details Reports the heap allocations made per frame, which should
+ *            be zero once the line buffers have grown to fit.
+ */
+static void BM_GameScreenRebuild(benchmark::State& state)
+{
+  GameSession session(DATA::diskReader(GAMEDATA_PATH));
+  session.load();
+  session.reset();
+  session.step("N");
+
+  GameScreen game_screen;
+  game_screen.update(session);
+
+  uint64_t allocations = BENCH::allocationCount();
+  for (auto _ : state)
+  {
+    game_screen.invalidate();
+    game_screen.input("GET CAND");
+    benchmark::DoNotOptimize(game_screen.update(session));
+  }
+  reportAllocations(state, allocations);
+}
+BENCHMARK(BM_GameScreenRebuild)->Unit(benchmark::kMicrosecond);
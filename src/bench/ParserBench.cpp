@@ -0,0 +1,42 @@
+//
+// Created by Zoe on 10/11/2019.
+//
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "map/WorldData.h"
+#include "session/CommandParser.h"
+#include "session/DataReader.h"
+
+/**
+ *   @brief   Parsing the commands a bot would send
+ *   @details Reports commands parsed per second and the heap
+ *            allocations made per command.
+ */
+static void BM_ParseCommand(benchmark::State& state)
+{
+  WorldData world_data;
+  world_data.load(DATA::diskReader(GAMEDATA_PATH));
+
+  const std::vector<std::string> commands = {
+    "N",          "GET CANDLE", "EXAMINE COAT", "OPEN DRAWER", "INV",
+    "LIGHT CAND", "SAY XZANFAR", "SWING AXE",   "XYZZY",       "LEAVE ROPE"
+  };
+
+  uint64_t allocations = BENCH::allocationCount();
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(COMMAND::parse(world_data, commands[i]));
+    i = i + 1 == commands.size() ? 0 : i + 1;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["allocs_per_command"] = benchmark::Counter(
+    static_cast<double>(BENCH::allocationCount() - allocations),
+    benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ParseCommand);
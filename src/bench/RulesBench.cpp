@@ -0,0 +1,40 @@
+//
+// Created by Zoe on 11/11/2019.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "map/WorldData.h"
+#include "session/ActionRules.h"
+#include "session/DataReader.h"
+
+/**
+ *   @brief   Checking action preconditions, done for every command
+ */
+static void BM_CheckPreconditions(benchmark::State& state)
+{
+  WorldData world_data;
+  world_data.load(DATA::diskReader(GAMEDATA_PATH));
+
+  SessionState session_state = world_data.startingState();
+  session_state.current_room = 28;
+  session_state.inventory.add(17, false);
+  session_state.inventory.add(12, false);
+  session_state.inventory.add(8, false);
+
+  // action ID and object index pairs
+  const int commands[][2] = { { 11, 18 }, { 11, 19 }, { 16, -1 }, { 17, 12 },
+                              { 20, 9 },  { 21, 16 }, { 6, 3 },   { 14, 2 } };
+  const size_t command_num = sizeof(commands) / sizeof(commands[0]);
+
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    int action = commands[i][0];
+    benchmark::DoNotOptimize(
+      RULES::check(world_data, session_state, &action, commands[i][1]));
+    i = i + 1 == command_num ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CheckPreconditions);
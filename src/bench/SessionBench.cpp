@@ -0,0 +1,253 @@
+//
+// Created by Zoe on 07/11/2019.
+//
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "map/WorldImage.h"
+#include "session/DataReader.h"
+#include "session/GameSession.h"
+#include "session/SessionHost.h"
+
+namespace
+{
+// the hosted sessions, and the commands each is sent per iteration
+const int HOSTED_SESSIONS = 2000;
+const int HOSTED_COMMANDS = 16;
+
+GameSession loadedSession()
+{
+  GameSession session(DATA::diskReader(GAMEDATA_PATH));
+  session.load();
+  session.reset();
+  return session;
+}
+
+/**
+ *   @brief   1 worker, then doubling up to one per hardware thread
+ */
+void workerCounts(benchmark::internal::Benchmark* benchmark)
+{
+  const int most =
+    static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  for (int workers = 1; workers < most; workers *= 2)
+  {
+    benchmark->Arg(workers);
+  }
+  benchmark->Arg(most);
+}
+}
+
+/**
+ *   @brief   Parsing the JSON game data from disk
+ */
+static void BM_WorldLoadSource(benchmark::State& state)
+{
+  auto read_file = DATA::diskReader(GAMEDATA_PATH);
+  for (auto _ : state)
+  {
+    WorldData world_data;
+    benchmark::DoNotOptimize(world_data.loadSource(read_file));
+  }
+}
+BENCHMARK(BM_WorldLoadSource)->Unit(benchmark::kMillisecond);
+
+/**
+ *   @brief   Mapping and reading the compiled world image from disk
+ */
+static void BM_WorldLoadImage(benchmark::State& state)
+{
+  auto read_file = DATA::diskReader(GAMEDATA_PATH);
+  for (auto _ : state)
+  {
+    DATA::FileBuffer image;
+    WorldData world_data;
+    if (!read_file(IMAGE::FILE_NAME, &image) ||
+        !world_data.loadImage(image.data(), image.size()))
+    {
+      state.SkipWithError("no valid world image, build WorldImage first");
+      break;
+    }
+  }
+}
+BENCHMARK(BM_WorldLoadImage)->Unit(benchmark::kMillisecond);
+
+/**
+ *   @brief   Reloading one JSON file into a loaded world
+ *   @details As the world watcher does when a file is edited: the
+ *            file is parsed and the world's word tables rebuilt.
+ *            Arg 0 is rooms.json, 1 objects.json and 2 actions.json.
+ */
+static void BM_WorldLoadFile(benchmark::State& state)
+{
+  const char* const file_names[] = { "rooms.json",
+                                     "objects.json",
+                                     "actions.json" };
+  const std::string file_name = file_names[state.range(0)];
+  auto read_file = DATA::diskReader(GAMEDATA_PATH);
+  WorldData world_data;
+  world_data.load(read_file);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(world_data.reload(read_file, file_name));
+  }
+  state.SetLabel(file_name);
+}
+BENCHMARK(BM_WorldLoadFile)
+  ->DenseRange(0, 2)
+  ->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   Starting a new game, e.g. PLAY AGAIN
+ */
+static void BM_SessionReset(benchmark::State& state)
+{
+  GameSession session = loadedSession();
+  for (auto _ : state)
+  {
+    session.reset();
+    benchmark::DoNotOptimize(session.response());
+  }
+}
+BENCHMARK(BM_SessionReset)->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   Running one command from start to finish
+ *   @details Parsing, checking, carrying out the action and checking
+ *            for the end of the game, with the response built. Mixes
+ *            moves, actions and commands that are refused.
+ */
+static void BM_SessionStep(benchmark::State& state)
+{
+  GameSession session = loadedSession();
+  const std::vector<std::string> commands = {
+    "N", "S", "GET COINS", "INV", "DROP COINS", "EXAMINE COINS", "XYZZY"
+  };
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(session.step(commands[i]));
+    i = i + 1 == commands.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SessionStep)->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   Creating a session from one that has already loaded
+ */
+static void BM_SessionCreate(benchmark::State& state)
+{
+  GameSession prototype = loadedSession();
+  for (auto _ : state)
+  {
+    GameSession session = prototype;
+    session.reset();
+    benchmark::DoNotOptimize(session.response());
+  }
+}
+BENCHMARK(BM_SessionCreate)->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   Saving a game in progress, e.g. the autosave after a command
+ */
+static void BM_SessionSave(benchmark::State& state)
+{
+  GameSession session = loadedSession();
+  session.step("GET COINS");
+  for (auto _ : state)
+  {
+    std::vector<char> save = session.saveGame();
+    benchmark::DoNotOptimize(save.data());
+  }
+}
+BENCHMARK(BM_SessionSave)->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   Loading a saved game, e.g. after a crash
+ */
+static void BM_SessionLoad(benchmark::State& state)
+{
+  GameSession session = loadedSession();
+  session.step("GET COINS");
+  std::vector<char> save = session.saveGame();
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(session.loadGame(save.data(), save.size()));
+  }
+  state.counters["bytes"] = static_cast<double>(save.size());
+}
+BENCHMARK(BM_SessionLoad)->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   A command then UNDO, with the journal full of earlier steps
+ */
+static void BM_SessionUndo(benchmark::State& state)
+{
+  GameSession session = loadedSession();
+  const char* const walk[] = { "N", "S" };
+  for (unsigned int i = 0; i < Journal::STEP_NUM; i++)
+  {
+    session.step(walk[i % 2]);
+  }
+  for (auto _ : state)
+  {
+    session.step("N");
+    benchmark::DoNotOptimize(session.step("UNDO"));
+  }
+  state.counters["steps"] = session.undoSteps();
+}
+BENCHMARK(BM_SessionUndo)->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   Many sessions sent commands at once, on a number of workers
+ *   @details Arg is the number of workers. Should scale with the workers
+ *            up to the number of cores. Each worker's commands a second
+ *            while busy is reported as wN_cps, and the batches it took
+ *            from other workers as wN_steals.
+ */
+static void BM_SessionHost(benchmark::State& state)
+{
+  SessionHost host(DATA::diskReader(GAMEDATA_PATH),
+                   static_cast<unsigned int>(state.range(0)));
+  host.load();
+  for (int i = 0; i < HOSTED_SESSIONS; i++)
+  {
+    host.createSession();
+  }
+  const std::vector<std::string> commands = {
+    "N", "S", "GET COINS", "INV", "DROP COINS", "EXAMINE COINS", "XYZZY"
+  };
+
+  for (auto _ : state)
+  {
+    for (int command = 0; command < HOSTED_COMMANDS; command++)
+    {
+      for (int session = 0; session < HOSTED_SESSIONS; session++)
+      {
+        host.submit(
+          session,
+          commands[static_cast<size_t>(session + command) % commands.size()]);
+      }
+    }
+    host.wait();
+  }
+  state.SetItemsProcessed(state.iterations() * HOSTED_SESSIONS *
+                          HOSTED_COMMANDS);
+
+  auto stats = host.workerStats();
+  for (size_t i = 0; i < stats.size(); i++)
+  {
+    const std::string worker = "w" + std::to_string(i);
+    state.counters[worker + "_cps"] = stats[i].commands_per_second;
+    state.counters[worker + "_steals"] = static_cast<double>(stats[i].steals);
+  }
+}
+BENCHMARK(BM_SessionHost)
+  ->Apply(workerCounts)
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
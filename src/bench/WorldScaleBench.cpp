@@ -0,0 +1,240 @@
+//
+// Created by Zoe on 13/11/2019.
+//
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "map/RoomGenerator.h"
+#include "map/WorldData.h"
+#include "map/WorldImage.h"
+#include "session/DataReader.h"
+#include "session/GameSession.h"
+
+namespace
+{
+const uint32_t WORLD_SEED = 1;
+
+struct GeneratedWorld
+{
+  std::string rooms;
+  std::vector<char> image;
+};
+
+/**
+ *   @brief   Generates the rooms of a world
+ *   @details Once per size, the rooms are kept in memory.
+ *   @param   room_count The number of rooms to generate.
+ */
+std::shared_ptr<GeneratedWorld> generatedWorld(int room_count)
+{
+  static std::map<int, std::shared_ptr<GeneratedWorld>> generated;
+
+  auto& world = generated[room_count];
+  if (!world)
+  {
+    WorldData world_data;
+    world_data.loadSource(DATA::diskReader(GAMEDATA_PATH));
+
+    world = std::make_shared<GeneratedWorld>();
+    world->rooms =
+      GENERATOR::rooms(room_count, world_data.objectCount(), WORLD_SEED);
+  }
+  return world;
+}
+
+/**
+ *   @brief   Reads a generated world's rooms, and its image if it has one
+ *   @details The objects and actions are the game's own.
+ */
+DATA::FileReader worldReader(std::shared_ptr<GeneratedWorld> world)
+{
+  auto read_file = DATA::diskReader(GAMEDATA_PATH);
+  return [world, read_file](const std::string& file,
+                            DATA::FileBuffer* contents) {
+    if (file == "rooms.json")
+    {
+      contents->assign(world->rooms.data(), world->rooms.size());
+      return true;
+    }
+    if (file == IMAGE::FILE_NAME)
+    {
+      contents->assign(world->image.data(), world->image.size());
+      return !world->image.empty();
+    }
+    return read_file(file, contents);
+  };
+}
+
+/**
+ *   @brief   Reads a generated world
+ *   @details The world is compiled into an image once per size. Sessions
+ *            load the image, loadSource() parses the rooms.
+ *   @param   room_count The number of rooms to generate.
+ */
+DATA::FileReader generatedReader(int room_count)
+{
+  auto world = generatedWorld(room_count);
+  auto reader = worldReader(world);
+  if (world->image.empty())
+  {
+    WorldData world_data;
+    uint32_t source_hash = 0;
+    world_data.loadSource(reader);
+    IMAGE::sourceHash(reader, &source_hash);
+    world->image = IMAGE::build(world_data, source_hash);
+  }
+  return reader;
+}
+
+void worldSizes(benchmark::internal::Benchmark* benchmark)
+{
+  benchmark->Arg(64)->Arg(10000)->Arg(1000000);
+}
+}
+
+/**
+ *   @brief   Parsing a generated world's JSON
+ */
+static void BM_WorldScaleLoadSource(benchmark::State& state)
+{
+  auto read_file = generatedReader(static_cast<int>(state.range(0)));
+  for (auto _ : state)
+  {
+    WorldData world_data;
+    benchmark::DoNotOptimize(world_data.loadSource(read_file));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WorldScaleLoadSource)
+  ->Apply(worldSizes)
+  ->Unit(benchmark::kMillisecond);
+
+/**
+ *   @brief   Parsing a very large generated world, and its peak memory
+ *   @details rooms.json is a few hundred megabytes. peak_bytes is the
+ *            most heap held during the load, including the copy of
+ *            rooms.json the reader hands over, so compare it with
+ *            file_bytes. world_bytes is what the loaded world keeps.
+ */
+static void BM_WorldScaleLoadLarge(benchmark::State& state)
+{
+  auto world = generatedWorld(static_cast<int>(state.range(0)));
+  auto read_file = worldReader(world);
+  uint64_t peak_bytes = 0;
+  uint64_t world_bytes = 0;
+  for (auto _ : state)
+  {
+    uint64_t start = BENCH::liveBytes();
+    BENCH::resetPeak();
+    auto world_data = std::unique_ptr<WorldData>(new WorldData());
+    benchmark::DoNotOptimize(world_data->loadSource(read_file));
+    peak_bytes = BENCH::peakBytes() - start;
+    world_bytes = BENCH::liveBytes() - start;
+  }
+  state.SetBytesProcessed(
+    state.iterations() * static_cast<int64_t>(world->rooms.size()));
+  state.counters["file_bytes"] = static_cast<double>(world->rooms.size());
+  state.counters["peak_bytes"] = static_cast<double>(peak_bytes);
+  state.counters["world_bytes"] = static_cast<double>(world_bytes);
+}
+BENCHMARK(BM_WorldScaleLoadLarge)
+  ->Arg(1000000)
+  ->Arg(2000000)
+  ->Iterations(1)
+  ->Unit(benchmark::kMillisecond);
+
+/**
+ *   @brief   Loading a generated world's compiled image from memory
+ */
+static void BM_WorldScaleLoadImage(benchmark::State& state)
+{
+  auto read_file = generatedReader(static_cast<int>(state.range(0)));
+  DATA::FileBuffer image;
+  read_file(IMAGE::FILE_NAME, &image);
+
+  for (auto _ : state)
+  {
+    WorldData world_data;
+    benchmark::DoNotOptimize(world_data.loadImage(image.data(), image.size()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["image_bytes"] = static_cast<double>(image.size());
+}
+BENCHMARK(BM_WorldScaleLoadImage)
+  ->Apply(worldSizes)
+  ->Unit(benchmark::kMillisecond);
+
+/**
+ *   @brief   Running commands in a generated world
+ *   @details Should not depend on the size of the world.
+ */
+static void BM_WorldScaleStep(benchmark::State& state)
+{
+  GameSession session(generatedReader(static_cast<int>(state.range(0))));
+  session.load();
+  session.reset();
+
+  const std::vector<std::string> commands = { "N", "E", "S", "W",
+                                              "GET CANDLE", "INV" };
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(session.step(commands[i]));
+    i = i + 1 == commands.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldScaleStep)
+  ->Apply(worldSizes)
+  ->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   Starting a new game in a generated world
+ *   @details Copies the starting state, so grows with the world.
+ */
+static void BM_WorldScaleReset(benchmark::State& state)
+{
+  GameSession session(generatedReader(static_cast<int>(state.range(0))));
+  session.load();
+  for (auto _ : state)
+  {
+    session.reset();
+    benchmark::DoNotOptimize(session.response());
+  }
+}
+BENCHMARK(BM_WorldScaleReset)
+  ->Apply(worldSizes)
+  ->Unit(benchmark::kMicrosecond);
+
+/**
+ *   @brief   The memory held by a generated world and by each session
+ */
+static void BM_WorldScaleMemory(benchmark::State& state)
+{
+  auto read_file = generatedReader(static_cast<int>(state.range(0)));
+  uint64_t world_bytes = 0;
+  uint64_t session_bytes = 0;
+  for (auto _ : state)
+  {
+    uint64_t start = BENCH::liveBytes();
+    auto world_data = std::unique_ptr<WorldData>(new WorldData());
+    world_data->load(read_file);
+    world_bytes = BENCH::liveBytes() - start;
+
+    start = BENCH::liveBytes();
+    auto session_state = std::unique_ptr<SessionState>(
+      new SessionState(world_data->startingState()));
+    session_bytes = BENCH::liveBytes() - start;
+  }
+  state.counters["world_bytes"] = static_cast<double>(world_bytes);
+  state.counters["session_bytes"] = static_cast<double>(session_bytes);
+}
+BENCHMARK(BM_WorldScaleMemory)
+  ->Apply(worldSizes)
+  ->Iterations(1)
+  ->Unit(benchmark::kMillisecond);
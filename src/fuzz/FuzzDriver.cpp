@@ -0,0 +1,249 @@
+//
+// Created by Zoe on 21/11/2019.
+//
+
+#include "SessionFuzzer.h"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+#if defined(__GNUC__)
+extern "C" void __sanitizer_set_death_callback(void (*callback)())
+  __attribute__((weak));
+#endif
+
+namespace
+{
+const char* const CRASH_FILE = "crash-input";
+const size_t MAX_POOL = 10000;
+
+// the input being run, written out if it crashes
+const char* volatile running_data = nullptr;
+volatile size_t running_size = 0;
+
+/**
+ *   @brief   Saves the input that was running
+ *   @details Called from a signal handler, so only uses calls that
+ *            are safe there.
+ */
+void saveRunningInput()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  int file = open(CRASH_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (file != -1)
+  {
+    ssize_t written = write(file, running_data, running_size);
+    close(file);
+    static const char message[] = "\nthe input was saved to crash-input\n";
+    if (written >= 0)
+    {
+      written = write(STDERR_FILENO, message, sizeof(message) - 1);
+    }
+  }
+#endif
+}
+
+void onCrash(int signal_number)
+{
+  saveRunningInput();
+  std::signal(signal_number, SIG_DFL);
+  std::raise(signal_number);
+}
+
+void catchCrashes()
+{
+  std::signal(SIGSEGV, onCrash);
+  std::signal(SIGABRT, onCrash);
+  std::signal(SIGFPE, onCrash);
+  std::signal(SIGILL, onCrash);
+#if defined(__GNUC__)
+  if (__sanitizer_set_death_callback != nullptr)
+  {
+    __sanitizer_set_death_callback(saveRunningInput);
+  }
+#endif
+}
+
+void run(const std::string& input)
+{
+  running_data = input.data();
+  running_size = input.size();
+  LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()),
+                         input.size());
+}
+
+bool readFile(const std::string& path, std::string* contents)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  std::ostringstream buffer;
+  buffer << file.rdbuf();
+  *contents = buffer.str();
+  return true;
+}
+
+/**
+ *   @brief   Changes an input a little
+ *   @details Mostly adds the world's words, so inputs read like
+ *            commands, with some raw bytes to reach the edge cases.
+ */
+void mutate(std::string* input,
+            const std::vector<std::string>& pool,
+            const std::vector<std::string>& words,
+            std::minstd_rand* random,
+            size_t max_length)
+{
+  auto pick = [random](size_t count) {
+    return static_cast<size_t>((*random)() % count);
+  };
+  const char separators[] = { '\n', ' ', '\n', '\0' };
+
+  const size_t changes = 1 + pick(4);
+  for (size_t i = 0; i < changes; i++)
+  {
+    const size_t at = pick(input->size() + 1);
+    switch (pick(6))
+    {
+      case 0:
+        input->insert(at, words[pick(words.size())] + separators[pick(4)]);
+        break;
+      case 1:
+        input->append("\n" + words[pick(words.size())] + " " +
+                      words[pick(words.size())]);
+        break;
+      case 2:
+        input->insert(at, 1, static_cast<char>(pick(256)));
+        break;
+      case 3:
+        if (!input->empty())
+        {
+          (*input)[pick(input->size())] = static_cast<char>(pick(256));
+        }
+        break;
+      case 4:
+        input->erase(at, pick(16));
+        break;
+      default:
+      {
+        const std::string& other = pool[pick(pool.size())];
+        const size_t from = pick(other.size() + 1);
+        input->insert(at, other, from, pick(64));
+        break;
+      }
+    }
+  }
+  if (input->size() > max_length)
+  {
+    input->resize(max_length);
+  }
+}
+
+long long option(const std::string& argument, const char* name)
+{
+  return std::atoll(argument.c_str() + std::strlen(name));
+}
+}
+
+/**
+ *   @brief   Runs the fuzz target without libFuzzer
+ *   @details For compilers that can't build -fsanitize=fuzzer, e.g.
+ *            GCC. Usage: SessionFuzzer [inputs...] [-runs=n] [-seed=n]
+ *            [-max_len=n]. Given only inputs, each is run once, to
+ *            reproduce a crash. Otherwise new inputs are made from the
+ *            given ones and the world's words until -runs have run, or
+ *            forever. An input that reaches a new game state is kept
+ *            and mutated further. A crashing input is saved to
+ *            crash-input.
+ */
+int main(int argc, char* argv[])
+{
+  long long runs = -1;
+  uint32_t seed = 1;
+  size_t max_length = 512;
+  std::vector<std::string> pool;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument = argv[i];
+    if (argument.compare(0, 6, "-runs=") == 0)
+    {
+      runs = option(argument, "-runs=");
+    }
+    else if (argument.compare(0, 6, "-seed=") == 0)
+    {
+      seed = static_cast<uint32_t>(option(argument, "-seed="));
+    }
+    else if (argument.compare(0, 9, "-max_len=") == 0)
+    {
+      max_length = static_cast<size_t>(option(argument, "-max_len="));
+    }
+    else
+    {
+      pool.emplace_back();
+      if (!readFile(argument, &pool.back()))
+      {
+        std::cerr << "could not read " << argument << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  catchCrashes();
+  if (runs == -1 && !pool.empty())
+  {
+    for (const auto& input : pool)
+    {
+      run(input);
+    }
+    std::cout << "ran " << pool.size() << " inputs" << std::endl;
+    return 0;
+  }
+
+  const std::vector<std::string> words = FUZZ::dictionary();
+  pool.push_back("");
+  std::unordered_set<uint64_t> states;
+  std::minstd_rand random(seed);
+
+  auto start = std::chrono::steady_clock::now();
+  std::string input;
+  for (long long i = 1; runs < 0 || i <= runs; i++)
+  {
+    input = pool[static_cast<size_t>(random()) % pool.size()];
+    mutate(&input, pool, words, &random, max_length);
+    run(input);
+
+    if (states.insert(FUZZ::stateSignature()).second &&
+        pool.size() < MAX_POOL)
+    {
+      pool.push_back(input);
+    }
+
+    if ((i & (i - 1)) == 0 || i == runs)
+    {
+      std::chrono::duration<double> seconds =
+        std::chrono::steady_clock::now() - start;
+      std::cout << "#" << i << " exec/s: "
+                << static_cast<long long>(static_cast<double>(i) /
+                                          std::max(seconds.count(), 1e-9))
+                << " states: " << states.size() << " pool: " << pool.size()
+                << std::endl;
+    }
+  }
+  return 0;
+}
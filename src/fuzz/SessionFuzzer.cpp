@@ -0,0 +1,194 @@
+//
+// Created by Zoe on 21/11/2019.
+//
+
+#include "SessionFuzzer.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "session/DataReader.h"
+#include "session/GameSession.h"
+
+namespace
+{
+// commands past this in one input are ignored, long inputs only repeat
+const int MAX_COMMANDS = 256;
+
+/**
+ *   @brief   The session every input is played in
+ *   @details The world is loaded once, the first time an input runs.
+ */
+GameSession& fuzzSession()
+{
+  static GameSession session = [] {
+    GameSession loaded(DATA::diskReader(GAMEDATA_PATH));
+    if (!loaded.load())
+    {
+      std::cerr << "could not load the game data in " << GAMEDATA_PATH
+                << std::endl;
+      std::abort();
+    }
+    loaded.seed(0);
+    loaded.reset();
+    return loaded;
+  }();
+  return session;
+}
+
+void broken(const char* problem)
+{
+  std::cerr << "broken state: " << problem << std::endl;
+  std::abort();
+}
+
+/**
+ *   @brief   Checks the tables in a session's state agree
+ *   @details Every object is in at most one place, the room lists are
+ *            linked both ways and only hold the room's objects, and
+ *            the inventory holds exactly the carried objects.
+ */
+void checkState(const WorldData& world_data, const SessionState& state)
+{
+  const int room_count = world_data.roomCount();
+  const int object_count = world_data.objectCount();
+  if (state.current_room < 0 || state.current_room >= room_count)
+  {
+    broken("the player is outside the world");
+  }
+
+  int in_rooms = 0;
+  int carried = 0;
+  for (int i = 0; i < object_count; i++)
+  {
+    int location = state.object_location[i];
+    if (location == DATA::CARRIED)
+    {
+      carried += 1;
+    }
+    else if (location >= 0 && location < room_count)
+    {
+      in_rooms += 1;
+    }
+    else if (location != DATA::NOWHERE)
+    {
+      broken("an object is in a room that doesn't exist");
+    }
+    if ((location == DATA::CARRIED) != (state.inventory.carried[i] != 0))
+    {
+      broken("an object is carried and not in the inventory");
+    }
+  }
+
+  int listed = 0;
+  for (int room = 0; room < room_count; room++)
+  {
+    int32_t previous = -1;
+    for (int32_t i = state.room_first[room]; i != -1;
+         i = state.object_next[i])
+    {
+      if (i < 0 || i >= object_count || ++listed > in_rooms)
+      {
+        broken("a room's list runs past its objects");
+      }
+      if (state.object_location[i] != room || state.object_prev[i] != previous)
+      {
+        broken("a room's list has an object from somewhere else");
+      }
+      previous = i;
+    }
+    if (state.room_last[room] != previous)
+    {
+      broken("a room's list doesn't end at its last object");
+    }
+  }
+  if (listed != in_rooms)
+  {
+    broken("an object in a room isn't in its list");
+  }
+
+  if (state.inventory.count != carried)
+  {
+    broken("the inventory count is wrong");
+  }
+  for (int i = 0; i < state.inventory.count; i++)
+  {
+    int32_t object = state.inventory.objects[i];
+    if (object < 0 || object >= object_count ||
+        state.object_location[object] != DATA::CARRIED)
+    {
+      broken("the inventory holds an object that isn't carried");
+    }
+  }
+}
+}
+
+/**
+ *   @brief   Plays one input from the start of the game
+ *   @param   data The input, one command per line.
+ *   @param   size The size of the input.
+ *   @return  0, inputs are never rejected.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  GameSession& session = fuzzSession();
+  static const SessionState start = session.snapshot();
+  session.restore(start);
+
+  const char* next = reinterpret_cast<const char*>(data);
+  const char* end = next + size;
+  std::string command;
+  for (int i = 0; i < MAX_COMMANDS && next != end; i++)
+  {
+    const char* line_end =
+      static_cast<const char*>(std::memchr(next, '\n', end - next));
+    if (line_end == nullptr)
+    {
+      line_end = end;
+    }
+
+    command.assign(next, line_end);
+    session.step(command);
+    checkState(session.worldData(), session.snapshot());
+    next = line_end == end ? end : line_end + 1;
+  }
+  return 0;
+}
+
+/**
+ *   @brief   Sums up where the last input left the player
+ *   @details Inputs that reach a new signature are worth mutating
+ *            further, when there's no coverage to go by.
+ */
+uint64_t FUZZ::stateSignature()
+{
+  const SessionState& state = fuzzSession().snapshot();
+  uint64_t signature = static_cast<uint64_t>(state.current_room);
+  signature = signature * 1024 + static_cast<uint64_t>(state.score & 1023);
+  signature = signature * 64 + static_cast<uint64_t>(state.inventory.count);
+  signature = signature * 2 + (state.light_ignited ? 1 : 0);
+  signature = signature * 2 + (state.axed_tree ? 1 : 0);
+  signature = signature * 2 + (state.up_tree ? 1 : 0);
+  signature = signature * 2 + (state.in_end_state ? 1 : 0);
+  signature = signature * 2 + (state.game_over ? 1 : 0);
+  return signature;
+}
+
+/**
+ *   @brief   The words the world knows, to build inputs from
+ */
+std::vector<std::string> FUZZ::dictionary()
+{
+  const WorldData& world_data = fuzzSession().worldData();
+  std::vector<std::string> words = { DATA::MAGIC_WORD, "UNDO 3", "NORTH",
+                                     "UP",             "DOWN" };
+  for (int i = 0; i < world_data.actionCount(); i++)
+  {
+    words.push_back(world_data.action(i).actionVerb());
+  }
+  for (int i = 0; i < world_data.objectCount(); i++)
+  {
+    words.push_back(world_data.object(i).objectName());
+  }
+  return words;
+}
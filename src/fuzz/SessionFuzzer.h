@@ -0,0 +1,28 @@
+//
+// Created by Zoe on 21/11/2019.
+//
+
+#ifndef PROJECT_SESSIONFUZZER_H
+#define PROJECT_SESSIONFUZZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ *  The fuzz target for the command parser and the game rules.
+ *  An input is split into lines and each line is typed into a headless
+ *  session as a command. The session is put back to the start of the
+ *  game from a snapshot in memory before every input, and the state is
+ *  checked for broken tables after every command.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace FUZZ
+{
+std::vector<std::string> dictionary();
+uint64_t stateSignature();
+}
+
+#endif // PROJECT_SESSIONFUZZER_H
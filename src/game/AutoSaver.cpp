@@ -0,0 +1,108 @@
+//
+// Created by Zoe on 16/11/2019.
+//
+
+#include "AutoSaver.h"
+#include <Engine/FileIO.h>
+
+AutoSaver::AutoSaver(std::string file_name) :
+  name(std::move(file_name)), thread(&AutoSaver::run, this)
+{
+}
+
+/**
+ *   @brief   Writes the last save, then stops the thread
+ */
+AutoSaver::~AutoSaver()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_one();
+  thread.join();
+}
+
+/**
+ *   @brief   Queues a save to be written
+ *   @details Replaces any save that hasn't been written yet.
+ *   @param   bytes The save, e.g. from GameSession::saveGame().
+ */
+void AutoSaver::save(std::vector<char> bytes)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.swap(bytes);
+    has_pending = true;
+  }
+  wake.notify_one();
+}
+
+/**
+ *   @brief   Reads a save back from one of the slots
+ *   @details Try the slots in order and load the first that is valid.
+ *   @param   slot The slot, 0 is always written first.
+ *   @param   bytes Set to the save's bytes.
+ *   @return  False if the slot couldn't be read.
+ */
+bool AutoSaver::read(int slot, std::vector<char>* bytes) const
+{
+  using File = ASGE::FILEIO::File;
+  File save_file = File();
+  if (!save_file.open(slotName(slot), File::IOMode::READ))
+  {
+    return false;
+  }
+
+  ASGE::FILEIO::IOBuffer buffer = save_file.read();
+  save_file.close();
+
+  bytes->assign(buffer.as_char(), buffer.as_char() + buffer.length);
+  return true;
+}
+
+void AutoSaver::run()
+{
+  std::vector<char> bytes;
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true)
+  {
+    wake.wait(lock, [this] { return has_pending || stopping; });
+    if (!has_pending)
+    {
+      return;
+    }
+
+    bytes.swap(pending);
+    has_pending = false;
+    lock.unlock();
+
+    for (int slot = 0; slot < SLOT_NUM; slot++)
+    {
+      write(slot, bytes);
+    }
+
+    lock.lock();
+  }
+}
+
+bool AutoSaver::write(int slot, const std::vector<char>& bytes) const
+{
+  using File = ASGE::FILEIO::File;
+  File save_file = File();
+  if (!save_file.open(slotName(slot), File::IOMode::WRITE))
+  {
+    return false;
+  }
+
+  ASGE::FILEIO::IOBuffer buffer;
+  buffer.append(bytes.data(), bytes.size());
+  bool saved = save_file.write(buffer) == bytes.size();
+  save_file.close();
+  return saved;
+}
+
+std::string AutoSaver::slotName(int slot) const
+{
+  return name + "." + std::to_string(slot);
+}
@@ -0,0 +1,52 @@
+//
+// Created by Zoe on 16/11/2019.
+//
+
+#ifndef PROJECT_AUTOSAVER_H
+#define PROJECT_AUTOSAVER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ *  Writes saves to disk on its own thread.
+ *  save() only hands the bytes over, so the game never waits on the
+ *  disk. If saves come in faster than they can be written only the
+ *  newest is kept. Every save is written to two slots one after the
+ *  other, so a crash part way through a write always leaves one whole
+ *  save behind.
+ */
+class AutoSaver
+{
+ public:
+  static const int SLOT_NUM = 2;
+
+  explicit AutoSaver(std::string file_name);
+  ~AutoSaver();
+
+  AutoSaver(const AutoSaver&) = delete;
+  AutoSaver& operator=(const AutoSaver&) = delete;
+
+  void save(std::vector<char> bytes);
+  bool read(int slot, std::vector<char>* bytes) const;
+
+ private:
+  void run();
+  bool write(int slot, const std::vector<char>& bytes) const;
+  std::string slotName(int slot) const;
+
+  std::string name;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::vector<char> pending;
+  bool has_pending = false;
+  bool stopping = false;
+
+  std::thread thread;
+};
+
+#endif // PROJECT_AUTOSAVER_H
@@ -0,0 +1,154 @@
+//
+// Created by Zoe on 24/11/2019.
+//
+
+#include "FramePacer.h"
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+
+namespace
+{
+// an idle screen is redrawn this often
+const std::chrono::seconds IDLE_REFRESH(1);
+
+// the CPU package's energy counter on Linux, often only root can read it
+const char* const ENERGY_FILE = "/sys/class/powercap/intel-rapl:0/energy_uj";
+
+double cpuSeconds()
+{
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+/**
+ *   @brief   The energy the CPU has used since some point, or -1
+ */
+double energyJoules()
+{
+#ifdef __linux__
+  std::ifstream file(ENERGY_FILE);
+  unsigned long long microjoules = 0;
+  if (file >> microjoules)
+  {
+    return static_cast<double>(microjoules) / 1e6;
+  }
+#endif
+  return -1;
+}
+}
+
+FramePacer::FramePacer(int frame_cap) :
+  next_tick(Clock::now()),
+  last_frame(Clock::now()),
+  start(Clock::now()),
+  start_cpu(cpuSeconds()),
+  start_joules(energyJoules())
+{
+  frameCap(frame_cap);
+  last_sample.joules = start_joules >= 0 ? 0 : -1;
+}
+
+/**
+ *   @brief   Sets the most frames drawn a second
+ */
+void FramePacer::frameCap(int frames_per_second)
+{
+  tick = std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double>(1.0 / std::max(1, frames_per_second)));
+}
+
+/**
+ *   @brief   Asks for a frame as soon as the cap allows
+ *   @details Safe to call from any thread.
+ */
+void FramePacer::request()
+{
+  requested.store(true, std::memory_order_relaxed);
+}
+
+/**
+ *   @brief   Draws frames at the cap while running
+ *   @details For anything that changes on its own, e.g. a counter.
+ */
+void FramePacer::animate(bool running)
+{
+  animating = running;
+}
+
+/**
+ *   @brief   Should a frame be drawn now
+ *   @details Call every time the loop wakes, after the update. Counts
+ *            the frame as drawn or skipped.
+ */
+bool FramePacer::frameDue()
+{
+  const Clock::time_point now = Clock::now();
+  bool wanted = requested.load(std::memory_order_relaxed) || animating ||
+                now - last_frame >= IDLE_REFRESH;
+  if (!wanted || now < next_tick)
+  {
+    skipped += 1;
+    return false;
+  }
+
+  requested.store(false, std::memory_order_relaxed);
+  frames += 1;
+  last_frame = now;
+  next_tick = now + tick;
+  return true;
+}
+
+/**
+ *   @brief   How long the loop can sleep before the next frame is due
+ *   @details It should still wake early for an input event, which may
+ *            ask for a frame.
+ */
+double FramePacer::waitSeconds() const
+{
+  const Clock::time_point now = Clock::now();
+  Clock::time_point wake = last_frame + IDLE_REFRESH;
+  if (requested.load(std::memory_order_relaxed) || animating)
+  {
+    wake = next_tick;
+  }
+  return std::max(0.0, std::chrono::duration<double>(wake - now).count());
+}
+
+/**
+ *   @brief   Everything counted since the pacer was made
+ */
+FramePacer::Usage FramePacer::total() const
+{
+  Usage usage;
+  usage.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  usage.frames = frames;
+  usage.skipped = skipped;
+  usage.cpu_seconds = cpuSeconds() - start_cpu;
+
+  double joules = energyJoules();
+  if (start_joules >= 0 && joules >= start_joules)
+  {
+    usage.joules = joules - start_joules;
+  }
+  return usage;
+}
+
+/**
+ *   @brief   Everything counted since the last sample
+ *   @details E.g. to show the frame rate and CPU use every second.
+ */
+FramePacer::Usage FramePacer::sample()
+{
+  Usage now = total();
+  Usage usage;
+  usage.seconds = now.seconds - last_sample.seconds;
+  usage.frames = now.frames - last_sample.frames;
+  usage.skipped = now.skipped - last_sample.skipped;
+  usage.cpu_seconds = now.cpu_seconds - last_sample.cpu_seconds;
+  if (now.joules >= 0 && last_sample.joules >= 0)
+  {
+    usage.joules = now.joules - last_sample.joules;
+  }
+  last_sample = now;
+  return usage;
+}
@@ -0,0 +1,69 @@
+//
+// Created by Zoe on 24/11/2019.
+//
+
+#ifndef PROJECT_FRAMEPACER_H
+#define PROJECT_FRAMEPACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ *  Decides when to draw a frame, for render-on-demand.
+ *  A frame is only drawn after something asked for one: an input
+ *  event, a change of state or a running animation, and never more
+ *  than frame cap times a second. Between frames the game loop sleeps
+ *  for waitSeconds(), or until the next input event. An idle screen is
+ *  still redrawn once a second, in case the window was uncovered.
+ *  Counts the frames drawn and skipped, and the CPU time and, where
+ *  the system reports it, the CPU's energy used.
+ */
+class FramePacer
+{
+ public:
+  static const int DEFAULT_FRAME_CAP = 60;
+
+  struct Usage
+  {
+    double seconds = 0;     /**< The wall clock time covered. */
+    uint64_t frames = 0;    /**< Frames drawn. */
+    uint64_t skipped = 0;   /**< Wake-ups with nothing to draw. */
+    double cpu_seconds = 0; /**< CPU time used by the whole process. */
+    double joules = -1;     /**< Energy used by the CPU, -1 if unknown. */
+  };
+
+  explicit FramePacer(int frame_cap = DEFAULT_FRAME_CAP);
+  ~FramePacer() = default;
+
+  FramePacer(const FramePacer&) = delete;
+  FramePacer& operator=(const FramePacer&) = delete;
+
+  void frameCap(int frames_per_second);
+  void request();
+  void animate(bool running);
+  bool frameDue();
+  double waitSeconds() const;
+
+  Usage total() const;
+  Usage sample();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  Clock::duration tick;
+  Clock::time_point next_tick;
+  Clock::time_point last_frame;
+  std::atomic<bool> requested{ true };
+  bool animating = false;
+
+  uint64_t frames = 0;
+  uint64_t skipped = 0;
+
+  Clock::time_point start;
+  double start_cpu = 0;
+  double start_joules = -1;
+  Usage last_sample;
+};
+
+#endif // PROJECT_FRAMEPACER_H
@@ -7,11 +7,33 @@
 
 namespace DATA
 {
-static const int ROOM_NUM = 64;
-static const int OBJECT_NUM = 26;
-static const int ACTION_NUM = 23;
-static const int TREASURE_NUM = 8;
-static const int SAY_RANDOM_ROOM_NUM = 39;
+static const int ROOM_ITEM_NUM = 5;
+
+static const int NOWHERE = -1; /**< Location of objects not in the world. */
+static const int CARRIED = -2; /**< Location of objects being carried. */
+
+static const int START_ROOM = 57;
+static const int START_LIGHT = 40;
+
+static const char* const MAGIC_WORD = "XZANFAR"; /**< Said to cast magic. */
+static const int UNDO_ACTION = 23; /**< Takes back commands, not journaled. */
+
+/** The rooms, objects and actions the game's rules refer to by ID. */
+static const int RULE_ROOM_NUM = 64;
+static const int RULE_OBJECT_NUM = 24;
+static const int RULE_ACTION_NUM = 24;
+
+const int NORTH = 0;
+const int EAST = 1;
+const int SOUTH = 2;
+const int WEST = 3;
+const int UP = 4;
+const int DOWN = 5;
+const int NORTH_EAST = 6;
+const int NORTH_WEST = 7;
+const int SOUTH_EAST = 8;
+const int SOUTH_WEST = 9;
+const int DIRECTION_NUM = 10;
 
 const int MENU_SCREEN = 0;
 const int GAME_SCREEN = 1;
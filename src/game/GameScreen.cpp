@@ -0,0 +1,119 @@
+//
+// Created by Zoe on 09/11/2019.
+//
+
+#include "GameScreen.h"
+
+namespace
+{
+const char* const DIRECTION_LABELS[DATA::DIRECTION_NUM] = {
+  "N", "E", "S", "W", "U", "D", "NE", "NW", "SE", "SW"
+};
+}
+
+GameScreen::GameScreen()
+{
+  lines[TITLE] = { "HAUNTED HOUSE ADVENTURE", 136, 80, 3 };
+  lines[TOP_RULE] = {
+    "===============================================", 0, 110, 2
+  };
+  lines[LOCATION] = { "", 10, 150, 2 };
+  lines[EXITS] = { "", 10, 190, 2 };
+  lines[ITEMS] = { "", 10, 230, 2 };
+  lines[MIDDLE_RULE] = {
+    "-----------------------------------------------", 0, 250, 2
+  };
+  lines[QUESTION] = { "WHAT WOULD YOU LIKE TO DO?", 10, 300, 2 };
+  lines[PROMPT] = { "> ", 15, 350, 2 };
+  lines[BOTTOM_RULE] = {
+    "-----------------------------------------------", 0, 380, 2
+  };
+  lines[RESPONSE] = { "", 10, 430, 2 };
+}
+
+/**
+ *   @brief   Brings the lines up to date with the session
+ *   @details Lines are only rebuilt when what they show has changed.
+ *   @param   session The session being shown.
+ *   @return  True if any line was rebuilt.
+ */
+bool GameScreen::update(GameSession& session)
+{
+  bool changed = false;
+
+  if (!built || world_revision != session.worldRevision())
+  {
+    buildWorld(session.world());
+    world_revision = session.worldRevision();
+    changed = true;
+  }
+
+  if (!built || response_revision != session.responseRevision())
+  {
+    lines[RESPONSE].text.assign(session.response());
+    response_revision = session.responseRevision();
+    changed = true;
+  }
+
+  built = true;
+  changed = changed || input_changed;
+  input_changed = false;
+  return changed;
+}
+
+/**
+ *   @brief   Updates the prompt line, call when the input changes
+ *   @param   input What the player has typed so far.
+ */
+void GameScreen::input(const std::string& input)
+{
+  lines[PROMPT].text.assign("> ");
+  lines[PROMPT].text.append(input);
+  input_changed = true;
+}
+
+/**
+ *   @brief   Rebuilds every line on the next update
+ */
+void GameScreen::invalidate()
+{
+  built = false;
+}
+
+const GameScreen::Line& GameScreen::line(int i) const
+{
+  return lines[i];
+}
+
+void GameScreen::buildWorld(const Map& map)
+{
+  std::string& location = lines[LOCATION].text;
+  location.assign("YOUR LOCATION: ");
+  location.append(map.currentRoom().roomName());
+
+  int room = map.currentRoom().roomID();
+  std::string& exits = lines[EXITS].text;
+  exits.assign("EXITS: ");
+  const char* separator = "";
+  for (int i = 0; i < DATA::DIRECTION_NUM; i++)
+  {
+    if (map.hasExit(room, i))
+    {
+      exits.append(separator);
+      exits.append(DIRECTION_LABELS[i]);
+      separator = ", ";
+    }
+  }
+
+  std::string& items_text = lines[ITEMS].text;
+  items_text.assign("ITEMS: ");
+  for (int object = map.firstObject(room); object != -1;
+       object = map.nextObject(object))
+  {
+    if (!map.objectHidden(object))
+    {
+      items_text.append(map.object(object).objectName());
+      items_text.append(", ");
+    }
+  }
+}
@@ -0,0 +1,65 @@
+//
+// Created by Zoe on 09/11/2019.
+//
+
+#ifndef PROJECT_GAMESCREEN_H
+#define PROJECT_GAMESCREEN_H
+
+#include "../session/GameSession.h"
+#include <cstdint>
+#include <string>
+
+/**
+ *  The text shown on the game screen.
+ *  Keeps every line of the screen between frames and only rebuilds a
+ *  line when the session's world, its response or the player's input
+ *  has changed since it was built. An idle frame just draws the lines
+ *  it already has.
+ */
+class GameScreen
+{
+ public:
+  struct Line
+  {
+    std::string text;
+    int x;
+    int y;
+    float scale;
+  };
+
+  enum LineID
+  {
+    TITLE,
+    TOP_RULE,
+    LOCATION,
+    EXITS,
+    ITEMS,
+    MIDDLE_RULE,
+    QUESTION,
+    PROMPT,
+    BOTTOM_RULE,
+    RESPONSE,
+    LINE_NUM
+  };
+
+  GameScreen();
+  ~GameScreen() = default;
+
+  bool update(GameSession& session);
+  void input(const std::string& input);
+  void invalidate();
+
+  const Line& line(int i) const;
+
+ private:
+  void buildWorld(const Map& map);
+
+  Line lines[LINE_NUM];
+
+  bool built = false;
+  bool input_changed = true;
+  uint32_t world_revision = 0;
+  uint32_t response_revision = 0;
+};
+
+#endif // PROJECT_GAMESCREEN_H
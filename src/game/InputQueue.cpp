@@ -0,0 +1,48 @@
+//
+// Created by Zoe on 25/11/2019.
+//
+
+#include "InputQueue.h"
+
+/**
+ *   @brief   Adds an event, only call from the producer
+ *   @return  False if the queue was full and the event was dropped.
+ */
+bool InputQueue::push(const KeyPress& press)
+{
+  const uint64_t at = tail.load(std::memory_order_relaxed);
+  if (at - head.load(std::memory_order_acquire) == CAPACITY)
+  {
+    drop_count.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  presses[at % CAPACITY] = press;
+  tail.store(at + 1, std::memory_order_release);
+  return true;
+}
+
+/**
+ *   @brief   Takes the oldest event, only call from the consumer
+ *   @return  False if the queue was empty.
+ */
+bool InputQueue::pop(KeyPress* press)
+{
+  const uint64_t at = head.load(std::memory_order_relaxed);
+  if (at == tail.load(std::memory_order_acquire))
+  {
+    return false;
+  }
+
+  *press = presses[at % CAPACITY];
+  head.store(at + 1, std::memory_order_release);
+  return true;
+}
+
+/**
+ *   @brief   How many events were dropped because the queue was full
+ */
+uint64_t InputQueue::dropped() const
+{
+  return drop_count.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,49 @@
+//
+// Created by Zoe on 25/11/2019.
+//
+
+#ifndef PROJECT_INPUTQUEUE_H
+#define PROJECT_INPUTQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ *  Hands key events from the input callback to the game's update.
+ *  A bounded, lock-free queue for one producer and one consumer: the
+ *  callback pushes every event as it is captured, and the update pops
+ *  them all, oldest first, so a slow frame only delays events and
+ *  never reorders or merges them. Events that arrive while the queue
+ *  is full are counted and dropped.
+ */
+class InputQueue
+{
+ public:
+  static const int CAPACITY = 1024;
+
+  struct KeyPress
+  {
+    int key = 0;
+    int action = 0;
+    int64_t time = 0; /**< When it was captured, see PROFILER::now(). */
+  };
+
+  InputQueue() = default;
+  ~InputQueue() = default;
+
+  InputQueue(const InputQueue&) = delete;
+  InputQueue& operator=(const InputQueue&) = delete;
+
+  bool push(const KeyPress& press);
+  bool pop(KeyPress* press);
+  uint64_t dropped() const;
+
+ private:
+  std::array<KeyPress, CAPACITY> presses;
+  std::atomic<uint64_t> head{ 0 }; /**< The next to pop, set by pop(). */
+  std::atomic<uint64_t> tail{ 0 }; /**< The next to push, set by push(). */
+  std::atomic<uint64_t> drop_count{ 0 };
+};
+
+#endif // PROJECT_INPUTQUEUE_H
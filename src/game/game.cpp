@@ -5,22 +5,58 @@
 #include <Engine/Keys.h>
 #include <Engine/Sprite.h>
 
-#include <iostream>
-#include <nlohmann/json.hpp>
-#include <sstream>
+#include <chrono>
+#include <cstdio>
 #include <string>
-#include <time.h>
 
 #include "game.h"
+
+// GLFW is linked in with ASGE, which doesn't ship its header
+extern "C" void glfwWaitEventsTimeout(double timeout);
+
+namespace
+{
+const char* const SESSION_LOG_FILE = "session.log";
+const size_t SESSION_LOG_LIMIT = 100000; /**< Commands, a few MB at most. */
+const char* const AUTOSAVE_FILE = "autosave";
+const char* const PROFILE_FILE = "profile.json";
+
+// GLFW's codes, ASGE::KEYS has no function keys
+const int KEY_PROFILER = 298;     /**< F9 */
+const int KEY_SAVE_PROFILE = 299; /**< F10 */
+
+// the overlay's percentiles are worked out this often, in ns
+const int64_t PROFILE_REFRESH = 500000000;
+
+bool readGameData(const std::string& file, DATA::FileBuffer* contents)
+{
+  using File = ASGE::FILEIO::File;
+  File data_file = File();
+
+  if (!data_file.open("/data/" + file, ASGE::FILEIO::File::IOMode::READ))
+  {
+    return false;
+  }
+
+  using Buffer = ASGE::FILEIO::IOBuffer;
+  Buffer buffer = data_file.read();
+  data_file.close();
+
+  contents->assign(buffer.as_char(), buffer.length);
+  return true;
+}
+}
+
 /**
  *   @brief   Default Constructor.
  *   @details Consider setting the game's width and height
  *            and even seeding the random number generator.
  */
-MyASGEGame::MyASGEGame()
+MyASGEGame::MyASGEGame() :
+  session(readGameData), auto_saver(AUTOSAVE_FILE)
 {
-  srand(time(NULL));
   game_name = "Haunted House Adventure";
+  session.recordLog(SESSION_LOG_LIMIT);
 }
 
 /**
@@ -37,71 +73,175 @@ MyASGEGame::~MyASGEGame()
 
 void MyASGEGame::play()
 {
-  map.reset();
+  session.reset();
+  auto_saver.save(session.saveGame());
+  resume();
+}
 
-  score = 0;
+/**
+ *   @brief   Shows the game in progress
+ */
+void MyASGEGame::resume()
+{
   std::string empty_input = "";
   input_controller.input(&empty_input);
-  num_objects_carrying = 0;
-  for (int i = 0; i < DATA::OBJECT_NUM; i++)
-  {
-    inventory[i] = -1;
-  }
 
-  screen_open = DATA::GAME_SCREEN;
+  game_screen.input(input_controller.input());
+  game_screen.invalidate();
 
-  in_end_state = false;
-  game_over = false;
+  screen_open = DATA::GAME_SCREEN;
   menu_option = 0;
+}
+
+/**
+ *   @brief   Loads the autosave left by the last run
+ *   @details The first slot is written first, so it is the newest if
+ *            it is whole. A game that ended can't be carried on.
+ *   @return  True if there is a game to carry on.
+ */
+bool MyASGEGame::recoverGame()
+{
+  std::vector<char> bytes;
+  for (int slot = 0; slot < AutoSaver::SLOT_NUM; slot++)
+  {
+    if (auto_saver.read(slot, &bytes) &&
+        session.loadGame(bytes.data(), bytes.size()))
+    {
+      return !session.gameOver();
+    }
+  }
+  return false;
+}
 
-  current_action = -1;
-  current_action_object = -1;
+/**
+ *   @brief   Saves the game just played
+ *   @details The log can be played back with the ReplayRunner tool to
+ *            see exactly what happened.
+ */
+void MyASGEGame::saveSessionLog()
+{
+  using File = ASGE::FILEIO::File;
+  File log_file = File();
+  if (!log_file.open(SESSION_LOG_FILE, File::IOMode::WRITE))
+  {
+    return;
+  }
 
-  axed_tree = false;
-  up_tree = false;
+  std::string text = REPLAY::format(session.log());
+  ASGE::FILEIO::IOBuffer buffer;
+  buffer.append(text.data(), text.size());
+  log_file.write(buffer);
+  log_file.close();
+}
 
-  say_value = "";
-  action_response = "The gate slams shut behind you.";
+/**
+ *   @brief   Starts or stops the profiler and its overlay
+ *   @details The overlay shows the frame, command and key to response
+ *            latency next to the FPS counter, from the zones still in
+ *            the profiler.
+ */
+void MyASGEGame::toggleProfiler()
+{
+  show_profile = !show_profile;
+  PROFILER::enable(show_profile);
+  frame_start = -1;
+  profile_refreshed = -1;
+  profile_lines[0] = "frame   p50 -- p99 --";
+  profile_lines[1] = "command p50 -- p99 --";
+  profile_lines[2] = "key     p50 -- p99 --";
+  profile_lines[3] = "";
+  frame_pacer.sample();
+  frame_pacer.animate(show_profile);
 }
 
-void MyASGEGame::loadWords()
+/**
+ *   @brief   Saves the profiler's zones as a Chrome trace
+ *   @details Open it in chrome://tracing to see where a slow frame
+ *            went.
+ */
+void MyASGEGame::saveProfile()
 {
   using File = ASGE::FILEIO::File;
-  File file = File();
+  File profile_file = File();
+  if (!profile_file.open(PROFILE_FILE, File::IOMode::WRITE))
+  {
+    return;
+  }
 
-  // Open file
-  if (file.open("/data/actions.json", ASGE::FILEIO::File::IOMode::READ))
+  std::string text = PROFILER::chromeTrace();
+  ASGE::FILEIO::IOBuffer buffer;
+  buffer.append(text.data(), text.size());
+  profile_file.write(buffer);
+  profile_file.close();
+}
+
+/**
+ *   @brief   Records the frame and rebuilds the overlay now and then
+ *   @details A frame is the time from one update to the next, so it
+ *            includes the render and any stall between them.
+ */
+void MyASGEGame::updateProfile()
+{
+  const int64_t now = PROFILER::now();
+  if (frame_start != -1)
+  {
+    PROFILER::record("frame", -1, frame_start, now);
+  }
+  frame_start = now;
+
+  if (profile_refreshed != -1 && now - profile_refreshed < PROFILE_REFRESH)
   {
-    // Get file data
-    using Buffer = ASGE::FILEIO::IOBuffer;
-    Buffer buffer = file.read();
-    file.close();
+    return;
+  }
+  profile_refreshed = now;
 
-    // Read file data as JSON
-    auto file_data =
-      nlohmann::json::parse(buffer.as_char(), buffer.as_char() + buffer.length);
+  const char* const zones[] = { "frame", "step", "keyToResponse" };
+  const char* const labels[] = { "frame  ", "command", "key    " };
+  char text[64];
+  for (int i = 0; i < 3; i++)
+  {
+    PROFILER::Latency latency = PROFILER::latency(zones[i]);
+    std::snprintf(text,
+                  sizeof(text),
+                  "%s p50 %.2fms p99 %.2fms",
+                  labels[i],
+                  latency.p50_ms,
+                  latency.p99_ms);
+    profile_lines[i] = text;
+  }
 
-    // Populate each action with it's information
-    for (const auto& action : file_data.items())
+  if (on_demand)
+  {
+    FramePacer::Usage usage = frame_pacer.sample();
+    std::snprintf(text,
+                  sizeof(text),
+                  "drawn %.0f/s skipped %.0f/s cpu %.1f%%",
+                  static_cast<double>(usage.frames) / usage.seconds,
+                  static_cast<double>(usage.skipped) / usage.seconds,
+                  usage.cpu_seconds / usage.seconds * 100.0);
+    profile_lines[3] = text;
+    if (usage.joules >= 0)
     {
-      int id = action.value()["ID"];
-      std::string verb = action.value()["Verb"];
-      int second_word = action.value()["Object"];
-      int required_objects[3] = { action.value()["Required Objects"][0],
-                                  action.value()["Required Objects"][1],
-                                  action.value()["Required Objects"][2] };
-      int required_room = action.value()["Required Room"];
-      std::string response = action.value()["Response"];
-
-      actions[id].setup(
-        id, verb, second_word, required_objects, required_room, response);
+      std::snprintf(
+        text, sizeof(text), " %.1fW", usage.joules / usage.seconds);
+      profile_lines[3] += text;
     }
-
-    std::cout << "Loaded Actions" << std::endl;
   }
-  else
+}
+
+/**
+ *   @brief   Plays a command typed on the game screen
+ *   @param   command The line typed, e.g. "GET ROPE".
+ */
+void MyASGEGame::runCommand(const std::string& command)
+{
+  session.step(command);
+  auto_saver.save(session.saveGame());
+
+  if (session.gameOver())
   {
-    std::cout << "Actions file not found" << std::endl;
+    saveSessionLog();
+    screen_open = DATA::GAME_OVER_SCREEN;
   }
 }
 
@@ -125,7 +265,8 @@ bool MyASGEGame::init()
 
   toggleFPS();
 
-  // input handling functions
+  // input handling functions, keyHandler only queues each key for the
+  // next update, so the callbacks run in order as GLFW delivers them
   inputs->use_threads = false;
 
   key_callback_id =
@@ -134,11 +275,106 @@ bool MyASGEGame::init()
   mouse_callback_id = inputs->addCallbackFnc(
     ASGE::E_MOUSE_CLICK, &MyASGEGame::clickHandler, this);
 
-  loadWords();
+  if (!session.load())
+  {
+    ASGE::DebugPrinter{} << "could not load the game data" << std::endl;
+    return false;
+  }
+  can_continue = recoverGame();
 
   return true;
 }
 
+/**
+ *   @brief   Reloads the world whenever its JSON files are edited
+ *   @details For working on the game data while the game runs. The
+ *            game in progress carries on in the new world, see
+ *            GameSession::reload(). Call after init().
+ *   @param   directory The folder holding the JSON files, e.g. the
+ *            source GameData folder.
+ *   @return  False if the folder couldn't be watched.
+ */
+bool MyASGEGame::watchWorld(const std::string& directory)
+{
+  world_watcher.reset(new WorldWatcher(
+    directory,
+    session.sharedWorldData(),
+    [this](std::shared_ptr<const WorldData> world_data) {
+      std::lock_guard<std::mutex> lock(world_mutex);
+      next_world = std::move(world_data);
+      frame_pacer.request();
+    }));
+  return world_watcher->start();
+}
+
+/**
+ *   @brief   Moves the session to the newest world from the watcher
+ */
+void MyASGEGame::reloadWorld()
+{
+  std::shared_ptr<const WorldData> world_data;
+  {
+    std::lock_guard<std::mutex> lock(world_mutex);
+    world_data.swap(next_world);
+  }
+  if (world_data)
+  {
+    session.reload(std::move(world_data));
+    game_screen.invalidate();
+  }
+}
+
+/**
+ *   @brief   Runs the game, only drawing frames that have changed
+ *   @details Replaces run() for always-on machines. The thread sleeps
+ *            in GLFW until an input event or the next frame is due,
+ *            then updates the game, and only draws a frame when the
+ *            screen has changed. ASGE polls for events when it swaps
+ *            buffers, so the wait takes over that job between frames.
+ *            The frames drawn and skipped and the CPU used are printed
+ *            on exit.
+ *   @param   frame_cap The most frames drawn a second.
+ *   @return  The exit code for the game.
+ */
+int MyASGEGame::runOnDemand(int frame_cap)
+{
+  using Clock = std::chrono::steady_clock;
+  on_demand = true;
+  frame_pacer.frameCap(frame_cap);
+  frame_pacer.request();
+  renderer->setWindowTitle(game_name.c_str());
+
+  ASGE::GameTime game_time;
+  const Clock::time_point start = Clock::now();
+  while (!exit && !renderer->exit())
+  {
+    const Clock::time_point now = Clock::now();
+    game_time.delta = now - game_time.frame_time;
+    game_time.elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
+    game_time.frame_time = now;
+
+    update(game_time);
+    if (frame_pacer.frameDue())
+    {
+      beginFrame();
+      render(game_time);
+      endFrame();
+    }
+    glfwWaitEventsTimeout(frame_pacer.waitSeconds());
+  }
+
+  FramePacer::Usage usage = frame_pacer.total();
+  ASGE::DebugPrinter{} << "drew " << usage.frames << " frames, skipped "
+                       << usage.skipped << ", CPU " << usage.cpu_seconds
+                       << "s in " << usage.seconds << "s" << std::endl;
+  if (usage.joules >= 0)
+  {
+    ASGE::DebugPrinter{} << "CPU energy " << usage.joules << "J" << std::endl;
+  }
+  return 0;
+}
+
 /**
  *   @brief   Sets the game window resolution
  *   @details This function is designed to create the window size, any
@@ -160,81 +396,81 @@ void MyASGEGame::setupResolution()
   game_height = 768;
 }
 
-void MyASGEGame::getAction()
+/**
+ *   @brief   Captures key inputs
+ *   @details This function is added as a callback to handle the game's
+ *            keyboard input. It only queues the key, with the time it
+ *            was pressed, for the next update to handle, so it never
+ *            touches the game's state.
+ *   @param   data The event data relating to key input.
+ *   @see     KeyEvent
+ *   @return  void
+ */
+void MyASGEGame::keyHandler(ASGE::SharedEventData data)
 {
-  std::istringstream iss(input_controller.input());
-  std::string action;
-  std::string object;
-  iss >> action;
-  iss >> object;
+  PROFILER::Zone zone("keyHandler");
+  auto key = static_cast<const ASGE::KeyEvent*>(data.get());
 
-  for (int i = 0; i < DATA::ACTION_NUM; i++)
-  {
-    if (actions[i].actionVerb() == action)
-    {
-      current_action = actions[i].actionID();
-      break;
-    }
-  }
+  InputQueue::KeyPress press;
+  press.key = key->key;
+  press.action = key->action;
+  press.time = PROFILER::now();
+  input_queue.push(press);
+  frame_pacer.request();
+}
 
-  if (current_action == -1)
-  {
-    action_response = "This is not a valid command.";
-  }
-  if (current_action == 15)
+/**
+ *   @brief   Handles a key taken from the input queue
+ *   @details Called by update() for every key, in the order pressed.
+ *   @param   press The key and what happened to it.
+ */
+void MyASGEGame::handleKey(const InputQueue::KeyPress& press)
+{
+  if (press.action == ASGE::KEYS::KEY_RELEASED && key_time == -1)
   {
-    current_action_object = 0;
-    say_value = object;
+    key_time = press.time;
   }
-  else
+
+  if (press.key == KEY_PROFILER)
   {
-    if (object == "")
+    if (press.action == ASGE::KEYS::KEY_RELEASED)
     {
-      current_action_object = -1;
+      toggleProfiler();
     }
-    else
+  }
+  else if (press.key == KEY_SAVE_PROFILE)
+  {
+    if (press.action == ASGE::KEYS::KEY_RELEASED)
     {
-      for (int i = 0; i < DATA::OBJECT_NUM; i++)
-      {
-        if (map.object(i).objectName() == object)
-        {
-          current_action_object = map.object(i).objectID() - 1;
-          break;
-        }
-      }
+      saveProfile();
     }
   }
-}
-
-/**
- *   @brief   Processes any key inputs
- *   @details This function is added as a callback to handle the game's
- *            keyboard input. For this game, calls to this function
- *            are thread safe, so you may alter the game's state as
- *            you see fit.
- *   @param   data The event data relating to key input.
- *   @see     KeyEvent
- *   @return  void
- */
-void MyASGEGame::keyHandler(ASGE::SharedEventData data)
-{
-  auto key = static_cast<const ASGE::KeyEvent*>(data.get());
-
-  if (key->key == ASGE::KEYS::KEY_ESCAPE)
+  else if (press.key == ASGE::KEYS::KEY_ESCAPE)
   {
+    if (screen_open == DATA::GAME_SCREEN)
+    {
+      saveSessionLog();
+    }
     signalExit();
   }
   else if (screen_open == DATA::MENU_SCREEN)
   {
-    input_controller.menuOption(key->key, key->action, &menu_option, 2);
+    const int option_num = can_continue ? 3 : 2;
+    input_controller.menuOption(
+      press.key, press.action, &menu_option, option_num);
 
-    if (key->key == ASGE::KEYS::KEY_ENTER &&
-        key->action == ASGE::KEYS::KEY_RELEASED)
+    if (press.key == ASGE::KEYS::KEY_ENTER &&
+        press.action == ASGE::KEYS::KEY_RELEASED)
     {
       if (menu_option == 0)
       {
         play();
       }
+      else if (menu_option == 1 && can_continue)
+      {
+        can_continue = false;
+        resume();
+      }
       else
       {
         signalExit();
@@ -243,23 +479,25 @@ void MyASGEGame::keyHandler(ASGE::SharedEventData data)
   }
   else if (screen_open == DATA::GAME_SCREEN)
   {
-    input_controller.update(key->key, key->action);
+    input_controller.update(press.key, press.action);
 
-    if (key->key == ASGE::KEYS::KEY_ENTER &&
-        key->action == ASGE::KEYS::KEY_RELEASED)
+    if (press.key == ASGE::KEYS::KEY_ENTER &&
+        press.action == ASGE::KEYS::KEY_RELEASED)
     {
-      getAction();
-
+      std::string command = input_controller.input();
       std::string empty_input = "";
       input_controller.input(&empty_input);
+      runCommand(command);
     }
+
+    game_screen.input(input_controller.input());
   }
   else if (screen_open == DATA::GAME_OVER_SCREEN)
   {
-    input_controller.menuOption(key->key, key->action, &menu_option, 3);
+    input_controller.menuOption(press.key, press.action, &menu_option, 3);
 
-    if (key->key == ASGE::KEYS::KEY_ENTER &&
-        key->action == ASGE::KEYS::KEY_RELEASED)
+    if (press.key == ASGE::KEYS::KEY_ENTER &&
+        press.action == ASGE::KEYS::KEY_RELEASED)
     {
       if (menu_option == 0)
       {
@@ -308,201 +546,34 @@ void MyASGEGame::clickHandler(ASGE::SharedEventData data)
  */
 void MyASGEGame::update(const ASGE::GameTime& game_time)
 {
-  if (screen_open == DATA::GAME_SCREEN && !game_over && current_action != -1 &&
-      validateInput())
+  if (show_profile)
   {
-    action_response = actions[current_action].output();
+    updateProfile();
+  }
+  PROFILER::Zone zone("update");
 
-    if (!checkFrozen())
+  // the frame showing the last key was swapped after the last render
+  if (key_shown)
+  {
+    if (PROFILER::enabled())
     {
-      switch (current_action)
-      {
-        case (0):
-        {
-          showActions();
-          break;
-        }
-        case (1):
-        {
-          showInventory();
-          break;
-        }
-        case (2):
-        {
-          action_response = map.moveNorth();
-          break;
-        }
-        case (3):
-        {
-          action_response = map.moveEast();
-          break;
-        }
-        case (4):
-        {
-          action_response = map.moveSouth();
-          break;
-        }
-        case (5):
-        {
-          action_response = map.moveWest();
-          break;
-        }
-        case (6):
-        case (7):
-        {
-          addObjectToInventory();
-
-          if (current_action_object + 1 == 15 &&
-              map.currentRoom().roomID() == 47)
-          {
-            map.changeExits(47, 0, false);
-            map.changeExits(47, 2, true);
-          }
-          break;
-        }
-        case (8):
-        {
-          examineObject();
-          break;
-        }
-        case (9):
-        {
-          removeObjectFromInventory();
-          break;
-        }
-        case (10):
-        {
-          showScore();
-          break;
-        }
-        case (11):
-        {
-          if (map.room(28).South())
-          {
-            action_response = "You've already done this action.";
-          }
-          else
-          {
-            action_response = actions[11].output();
-            map.changeExits(28, 2, true);
-          }
-          break;
-        }
-        case (12):
-        {
-          if (map.object(16).hidden())
-          {
-            action_response = actions[12].output();
-            map.revealObject(16);
-          }
-          else
-          {
-            action_response = "You've already done this action.";
-          }
-          break;
-        }
-        case (15):
-        {
-          say();
-          break;
-        }
-        case (16):
-        {
-          if (map.room(31).West())
-          {
-            action_response = "You've already done this action.";
-          }
-          else if (map.currentRoom().roomID() == 30 ||
-                   map.currentRoom().roomID() == 31)
-          {
-            map.changeExits(31, 3, true);
-            map.changeExits(30, 1, true);
-          }
-          break;
-        }
-        case (17):
-        {
-          if (map.currentRoom().roomID() == 7)
-          {
-            action_response = "TIMBERRRRR!";
-            axed_tree = true;
-          }
-          else if (map.currentRoom().roomID() == 43)
-          {
-            if (map.room(43).North())
-            {
-              action_response = "You've already done this action.";
-            }
-            else
-            {
-              action_response = "You broke the thin wall.\nA secret room to "
-                                "the NORTH appears.";
-              map.changeExits(43, 0, true);
-            }
-          }
-          else
-          {
-            action_response = actions[current_action].output();
-          }
-          break;
-        }
-        case (18):
-        {
-          if (axed_tree)
-          {
-            action_response = "You cut the tree down, you can't climb it "
-                              "now.";
-          }
-          else
-          {
-            if (up_tree)
-            {
-              action_response = "You climb down the tree.";
-              up_tree = false;
-            }
-            else
-            {
-              if (checkInventory(3) == -1)
-              {
-                action_response = "You fall out of the tree! OUCH!";
-              }
-              else
-              {
-                action_response = actions[current_action].output();
-                up_tree = true;
-              }
-            }
-          }
-          break;
-        }
-        case (19):
-        {
-          action_response = map.removeBats();
-          break;
-        }
-        case (20):
-        {
-          action_response = map.removeGhosts();
-          break;
-        }
-        case (21):
-        {
-          action_response = map.lightCandle();
-          break;
-        }
-        case (22):
-        {
-          map.unlightCandle();
-          break;
-        }
-        default:
-          break;
-      }
+      PROFILER::record("keyToResponse", -1, key_time, PROFILER::now());
     }
-    current_action = -1;
-    current_action_object = -1;
+    key_time = -1;
+    key_shown = false;
+  }
 
-    checkEndState();
+  reloadWorld();
+
+  InputQueue::KeyPress press;
+  while (input_queue.pop(&press))
+  {
+    handleKey(press);
+  }
+
+  if (screen_open == DATA::GAME_SCREEN && game_screen.update(session))
+  {
+    frame_pacer.request();
   }
 }
 
@@ -515,7 +586,17 @@ void MyASGEGame::update(const ASGE::GameTime& game_time)
  */
 void MyASGEGame::render(const ASGE::GameTime&)
 {
+  PROFILER::Zone zone("render");
   renderer->setFont(0);
+  key_shown = key_time != -1;
+
+  if (show_profile)
+  {
+    renderer->renderText(profile_lines[0], 200, 20, 1, ASGE::COLOURS::GRAY);
+    renderer->renderText(profile_lines[1], 200, 40, 1, ASGE::COLOURS::GRAY);
+    renderer->renderText(profile_lines[2], 200, 60, 1, ASGE::COLOURS::GRAY);
+    renderer->renderText(profile_lines[3], 200, 80, 1, ASGE::COLOURS::GRAY);
+  }
 
   if (screen_open == DATA::MENU_SCREEN)
   {
@@ -525,68 +606,38 @@ void MyASGEGame::render(const ASGE::GameTime&)
                          350,
                          2,
                          ASGE::COLOURS::GRAY);
-    renderer->renderText(menu_option == 1 ? ">> QUIT" : "   QUIT",
+    if (can_continue)
+    {
+      renderer->renderText(menu_option == 1 ? ">> CONTINUE" : "   CONTINUE",
+                           437,
+                           450,
+                           2,
+                           ASGE::COLOURS::GRAY);
+    }
+    const int quit_option = can_continue ? 2 : 1;
+    renderer->renderText(menu_option == quit_option ? ">> QUIT" : "   QUIT",
                          437,
-                         450,
+                         can_continue ? 550 : 450,
                          2,
                          ASGE::COLOURS::GRAY);
   }
   else if (screen_open == DATA::GAME_SCREEN)
   {
-    renderer->renderText(
-      "HAUNTED HOUSE ADVENTURE", 136, 80, 3, ASGE::COLOURS::GRAY);
-    renderer->renderText("===============================================",
-                         0,
-                         110,
-                         2,
-                         ASGE::COLOURS::GRAY);
-    renderer->renderText("YOUR LOCATION: " + map.currentRoom().roomName(),
-                         10,
-                         150,
-                         2,
-                         ASGE::COLOURS::GRAY);
-
-    std::string exits = "";
-    exits += map.currentRoom().North() ? "N, " : "";
-    exits += map.currentRoom().East() ? "E, " : "";
-    exits += map.currentRoom().South() ? "S, " : "";
-    exits += map.currentRoom().West() ? "W" : "";
-
-    renderer->renderText("EXITS: " + exits, 10, 190, 2, ASGE::COLOURS::GRAY);
-
-    std::string items_text = "";
-    int* items = map.currentRoom().roomObjects();
-    for (int i = 0; i < 5; i++)
+    for (int i = 0; i < GameScreen::LINE_NUM; i++)
     {
-      if (items[i] != -1 && !map.object(items[i] - 1).hidden())
-      {
-        items_text += map.object(items[i] - 1).objectName() + ", ";
-      }
+      const GameScreen::Line& line = game_screen.line(i);
+      renderer->renderText(
+        line.text, line.x, line.y, line.scale, ASGE::COLOURS::GRAY);
     }
-
-    renderer->renderText(
-      "ITEMS: " + items_text, 10, 230, 2, ASGE::COLOURS::GRAY);
-    renderer->renderText("-----------------------------------------------",
-                         0,
-                         250,
-                         2,
-                         ASGE::COLOURS::GRAY);
-    renderer->renderText(
-      "WHAT WOULD YOU LIKE TO DO?", 10, 300, 2, ASGE::COLOURS::GRAY);
-    renderer->renderText(
-      "> " + input_controller.input(), 15, 350, 2, ASGE::COLOURS::GRAY);
-    renderer->renderText("-----------------------------------------------",
-                         0,
-                         380,
-                         2,
-                         ASGE::COLOURS::GRAY);
-    renderer->renderText(action_response, 10, 430, 2, ASGE::COLOURS::GRAY);
   }
   else if (screen_open == DATA::GAME_OVER_SCREEN)
   {
     renderer->renderText("GAME OVER", 377, 200, 3, ASGE::COLOURS::GRAY);
-    renderer->renderText(
-      "Score: " + std::to_string(score), 411, 240, 2, ASGE::COLOURS::GRAY);
+    renderer->renderText("Score: " + std::to_string(session.playerScore()),
+                         411,
+                         240,
+                         2,
+                         ASGE::COLOURS::GRAY);
     renderer->renderText(menu_option == 0 ? ">> PLAY AGAIN" : "   PLAY AGAIN",
                          372,
                          375,
@@ -605,332 +656,3 @@ void MyASGEGame::render(const ASGE::GameTime&)
   }
 }
 
-int MyASGEGame::checkInventory(int ID)
-{
-  for (int i = 0; i < DATA::OBJECT_NUM; i++)
-  {
-    if (inventory[i] == ID)
-    {
-      return i;
-    }
-  }
-  return -1;
-}
-
-void MyASGEGame::checkEndState()
-{
-  if (!in_end_state)
-  {
-    bool items_collected = true;
-    for (int i = 0; i < DATA::TREASURE_NUM; i++)
-    {
-      if (checkInventory(map.treasure(i)) == -1)
-      {
-        items_collected = false;
-        break;
-      }
-    }
-
-    if (items_collected)
-    {
-      map.changeExits(41, 2, true);
-      in_end_state = true;
-    }
-  }
-
-  if (in_end_state)
-  {
-    if (map.currentRoom().roomID() == 57)
-    {
-      game_over = true;
-      setScore();
-      screen_open = DATA::GAME_OVER_SCREEN;
-    }
-    else
-    {
-      action_response += "\nYou have collected all the treasures!\nHead "
-                         "back to the gate to see your score.";
-    }
-  }
-}
-
-void MyASGEGame::setScore()
-{
-  score = 0;
-  for (int i = 0; i < DATA::OBJECT_NUM; i++)
-  {
-    if (inventory[i] != -1)
-    {
-      if (map.object(inventory[i]).treasure())
-      {
-        score += 10;
-      }
-      else
-      {
-        score += 1;
-      }
-    }
-  }
-}
-
-bool MyASGEGame::validateInput()
-{
-  // Check has two words if needed
-  if (actions[current_action].actionObject() != -1 &&
-      current_action_object == -1)
-  {
-    action_response = "You need to say a valid object with\nthis action.";
-    return false;
-  }
-  // Check correct object
-  if (current_action == 11 || current_action == 13)
-  {
-    if (current_action_object + 1 == actions[current_action + 1].actionObject())
-    {
-      current_action += 1;
-    }
-  }
-  else if (actions[current_action].actionObject() > 0 &&
-           current_action_object + 1 != actions[current_action].actionObject())
-  {
-    action_response = "You can't do that.";
-    return false;
-  }
-
-  // Check have objects
-  if (actions[current_action].objectsNeeded()[0] != -1)
-  {
-    bool has_objects = true;
-    for (int i = 0; i < 3; i++)
-    {
-      int obj = actions[current_action].objectsNeeded()[i];
-      if (obj != -1 && checkInventory(obj - 1) == -1)
-      {
-        has_objects = false;
-      }
-
-      if (!has_objects)
-      {
-        action_response = "You don't have the required objects\nto "
-                          "complete this action.";
-        return false;
-      }
-    }
-  }
-  // Check correct room
-  if (actions[current_action].requiredRoom() != -1 &&
-      actions[current_action].requiredRoom() != map.currentRoom().roomID())
-  {
-    action_response = "You can't do this here.";
-    return false;
-  }
-
-  return true;
-}
-
-void MyASGEGame::showActions()
-{
-  for (int i = 0; i < DATA::ACTION_NUM; i++)
-  {
-    if (i % 7 == 0 && i != 0)
-    {
-      action_response += "\n";
-    }
-
-    if (i != 12 && i != 14)
-    {
-      action_response += actions[i].actionVerb() + ", ";
-    }
-  }
-}
-
-void MyASGEGame::showInventory()
-{
-  for (int i = 0; i < DATA::OBJECT_NUM; i++)
-  {
-    if (inventory[i] != -1)
-    {
-      if (i % 4 == 0 && i != 0)
-      {
-        action_response += "\n";
-      }
-      action_response += map.object(inventory[i]).objectName() + ", ";
-    }
-  }
-}
-
-void MyASGEGame::addObjectToInventory()
-{
-  int index = map.checkRoom(current_action_object + 1);
-  if (index != -1 && map.object(current_action_object).collectible() &&
-      !map.object(current_action_object).hidden())
-  {
-    map.removeObjectFromCurrentRoom(index);
-    inventory[num_objects_carrying] = current_action_object;
-    num_objects_carrying += 1;
-    action_response =
-      "You picked up " + map.object(current_action_object).objectName();
-  }
-  else if (map.object(current_action_object).collectible())
-  {
-    action_response = "There is no " +
-                      map.object(current_action_object).objectName() +
-                      " in this room";
-  }
-  else
-  {
-    action_response =
-      "You cannot pickup " + map.object(current_action_object).objectName();
-  }
-}
-
-void MyASGEGame::removeObjectFromInventory()
-{
-  bool space_in_room = false;
-  int inventory_index = 0;
-  for (int i = 0; i < 5; i++)
-  {
-    if (map.currentRoom().roomObjects()[i] == -1)
-    {
-      space_in_room = true;
-      inventory_index = i;
-      break;
-    }
-  }
-
-  if (space_in_room)
-  {
-    int index = checkInventory(current_action_object);
-    if (index == -1)
-    {
-      action_response =
-        "You aren't carrying " + map.object(current_action_object).objectName();
-    }
-    else
-    {
-      map.currentRoom().roomObjects()[inventory_index] =
-        current_action_object + 1;
-      for (int i = index; i < num_objects_carrying; i++)
-      {
-        if (i == DATA::OBJECT_NUM - 1)
-        {
-          inventory[1] = -1;
-        }
-        else
-        {
-          inventory[i] = inventory[i + 1];
-        }
-      }
-
-      inventory[num_objects_carrying] = -1;
-      num_objects_carrying -= 1;
-      action_response =
-        "You dropped " + map.object(current_action_object).objectName();
-    }
-  }
-  else
-  {
-    action_response = "There is no space to put down\n" +
-                      map.object(current_action_object).objectName() +
-                      " try a different room";
-  }
-}
-
-void MyASGEGame::examineObject()
-{
-  if ((map.checkRoom(current_action_object + 1) != -1 ||
-       checkInventory(current_action_object) != -1) &&
-      !map.object(current_action_object).hidden())
-  {
-    action_response = map.object(current_action_object).examine();
-  }
-  else
-  {
-    action_response =
-      "There is no " + map.object(current_action_object).objectName() + " here";
-  }
-
-  if (current_action_object + 1 == 22 && map.object(17).hidden())
-  {
-    map.revealObject(17);
-    action_response += "\nA key is revealed!";
-  }
-  else if (current_action_object + 1 == 20)
-  {
-    action_response = map.object(current_action_object).examine();
-  }
-}
-
-void MyASGEGame::showScore()
-{
-  setScore();
-  action_response = "Your score is: " + std::to_string(score);
-}
-
-void MyASGEGame::say()
-{
-  action_response = "You said '" + say_value + "'";
-
-  if (say_value == "XZANFAR")
-  {
-    action_response += "\n*MAGIC OCCURS*";
-    if (map.currentRoom().roomID() == 45)
-    {
-      action_response += "\nThe magical barrier falls";
-      map.changeExits(45, 3, true);
-    }
-    else
-    {
-      map.magicRandomRoom();
-    }
-  }
-}
-
-bool MyASGEGame::checkFrozen()
-{
-  if (map.currentRoom().roomID() == 13 && map.checkRoom(23) != -1)
-  {
-    action_response = "The bats frighten you,\nyou're too scared to do "
-                      "anything but run!";
-    if (current_action == 5)
-    {
-      action_response = map.moveWest();
-      action_response = "You flee.";
-    }
-    else if (current_action == 19)
-    {
-      action_response = map.removeBats();
-    }
-    return true;
-  }
-  if (map.currentRoom().roomID() == 52 && map.checkRoom(24) != -1)
-  {
-    action_response = "The ghosts frighten you,\nyou're too scared to do "
-                      "anything but run!";
-    if (current_action == 2)
-    {
-      action_response = map.moveNorth();
-      action_response = "You flee.";
-    }
-    else if (current_action == 20)
-    {
-      action_response = map.removeGhosts();
-    }
-    return true;
-  }
-
-  if ((map.currentRoom().roomID() == 61 || map.currentRoom().roomID() == 62) &&
-      checkInventory(14) != -1)
-  {
-    action_response = "The boat get's stuck,\nyou have to leave it behind.";
-    if (current_action == 9 && current_action_object + 1 == 15)
-    {
-      removeObjectFromInventory();
-      action_response = "You get out of the boat.";
-      map.changeExits(47, 0, true);
-      map.changeExits(47, 2, false);
-    }
-    return true;
-  }
-  return false;
-}
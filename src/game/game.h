@@ -1,13 +1,19 @@
 #pragma once
 #include <Engine/OGLGame.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 
-#include "../Action.h"
 #include "../Input.h"
-#include "../map/Map.h"
-#include "../map/Object.h"
-#include "../map/Room.h"
+#include "../session/GameSession.h"
+#include "../session/Profiler.h"
+#include "../session/WorldWatcher.h"
+#include "AutoSaver.h"
+#include "FramePacer.h"
+#include "InputQueue.h"
 #include "GameConstants.h"
+#include "GameScreen.h"
 
 /**
  *  An OpenGL Game based on ASGE.
@@ -18,9 +24,12 @@ class MyASGEGame : public ASGE::OGLGame
   MyASGEGame();
   ~MyASGEGame() final;
   bool init() override;
+  int runOnDemand(int frame_cap);
+  bool watchWorld(const std::string& directory);
 
  private:
   void keyHandler(ASGE::SharedEventData data);
+  void handleKey(const InputQueue::KeyPress& press);
   void clickHandler(ASGE::SharedEventData data);
   void setupResolution();
 
@@ -28,49 +37,39 @@ class MyASGEGame : public ASGE::OGLGame
   void render(const ASGE::GameTime&) override;
 
   void play();
-  void loadWords();
-
-  int checkInventory(int ID);
-  void checkEndState();
-  void setScore();
-  bool validateInput();
-  void getAction();
-
-  void showActions();
-  void showInventory();
-
-  void addObjectToInventory();
-  void removeObjectFromInventory();
-
-  void examineObject();
-  void showScore();
-  void say();
-  bool checkFrozen();
+  void runCommand(const std::string& command);
+  void resume();
+  bool recoverGame();
+  void saveSessionLog();
+  void toggleProfiler();
+  void saveProfile();
+  void updateProfile();
+  void reloadWorld();
 
   int key_callback_id = -1;   /**< Key Input Callback ID. */
   int mouse_callback_id = -1; /**< Mouse Input Callback ID. */
 
-  bool in_end_state = false;
-  bool game_over = false;
   int screen_open = 0;
   int menu_option = 0;
+  bool can_continue = false; /**< An unfinished game was recovered. */
 
-  Map map = Map();
+  GameSession session;
+  AutoSaver auto_saver;
+  FramePacer frame_pacer;
+  bool on_demand = false; /**< Frames are only drawn when needed. */
   Input input_controller = Input();
+  InputQueue input_queue;
+  GameScreen game_screen;
 
-  Action actions[DATA::ACTION_NUM];
-
-  int inventory[DATA::OBJECT_NUM] = { -1 };
-  int num_objects_carrying = 0;
-
-  int current_action = -1;
-  int current_action_object = -1;
-
-  int score = 0;
+  int64_t key_time = -1;  /**< When the oldest key not yet shown came. */
+  bool key_shown = false; /**< It was drawn in the last frame. */
 
-  bool axed_tree = false;
-  bool up_tree = false;
+  bool show_profile = false;
+  int64_t frame_start = -1;       /**< When the last update began. */
+  int64_t profile_refreshed = -1; /**< When the overlay was rebuilt. */
+  std::string profile_lines[4];
 
-  std::string say_value = "";
-  std::string action_response = "";
+  std::mutex world_mutex;
+  std::shared_ptr<const WorldData> next_world; /**< Taken by update(). */
+  std::unique_ptr<WorldWatcher> world_watcher; /**< Stopped first. */
 };
\ No newline at end of file
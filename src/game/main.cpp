@@ -1,10 +1,44 @@
 #include "game.h"
-int main()
+#include <cstdlib>
+#include <cstring>
+
+/**
+ *   @brief   Starts the game
+ *   @details Pass --on-demand to only draw frames when the screen
+ *            changes, e.g. on a kiosk, optionally followed by the most
+ *            frames to draw a second. Pass --watch and a game data
+ *            folder to reload the world whenever its JSON files are
+ *            edited.
+ */
+int main(int argc, char* argv[])
 {
   MyASGEGame asge_game;
   if (asge_game.init())
   {
+    bool on_demand = false;
+    int frame_cap = 0;
+    for (int i = 1; i < argc; i++)
+    {
+      if (std::strcmp(argv[i], "--on-demand") == 0)
+      {
+        on_demand = true;
+        if (i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+        {
+          frame_cap = std::atoi(argv[++i]);
+        }
+      }
+      else if (std::strcmp(argv[i], "--watch") == 0 && i + 1 < argc)
+      {
+        asge_game.watchWorld(argv[++i]);
+      }
+    }
+
+    if (on_demand)
+    {
+      return asge_game.runOnDemand(
+        frame_cap > 0 ? frame_cap : FramePacer::DEFAULT_FRAME_CAP);
+    }
     asge_game.run();
   }
   return 0;
-}
\ No newline at end of file
+}
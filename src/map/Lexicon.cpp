@@ -0,0 +1,87 @@
+//
+// Created by Zoe on 10/11/2019.
+//
+
+#include "Lexicon.h"
+#include <algorithm>
+
+/**
+ *   @brief   Adds a word
+ *   @details If a word is added more than once the first ID is kept.
+ *   @param   word The word, in upper case.
+ *   @param   id What the word maps to.
+ */
+void Lexicon::add(const std::string& word, int id)
+{
+  entries.push_back({ word, id });
+}
+
+/**
+ *   @brief   Sorts the words ready for lookups
+ */
+void Lexicon::compile()
+{
+  std::stable_sort(
+    entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+      return a.word < b.word;
+    });
+
+  auto last = std::unique(
+    entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+      return a.word == b.word;
+    });
+  entries.erase(last, entries.end());
+}
+
+void Lexicon::clear()
+{
+  entries.clear();
+}
+
+/**
+ *   @brief   Looks up a word or an abbreviation of it
+ *   @param   word The start of the word, need not be null terminated.
+ *   @param   length The number of characters in the word.
+ *   @return  The word's ID, or -1 if it isn't known or the abbreviation
+ *            could be more than one word.
+ */
+int Lexicon::find(const char* word, size_t length) const
+{
+  if (length == 0)
+  {
+    return -1;
+  }
+
+  auto first = std::lower_bound(
+    entries.begin(),
+    entries.end(),
+    0,
+    [word, length](const Entry& entry, int) {
+      return entry.word.compare(0, std::string::npos, word, length) < 0;
+    });
+
+  auto starts_with = [word, length](const Entry& entry) {
+    return entry.word.compare(0, length, word, length) == 0;
+  };
+
+  if (first == entries.end() || !starts_with(*first))
+  {
+    return -1;
+  }
+
+  // an exact match sorts before every longer word sharing its prefix
+  if (first->word.size() == length)
+  {
+    return first->id;
+  }
+
+  for (auto entry = first + 1; entry != entries.end() && starts_with(*entry);
+       ++entry)
+  {
+    if (entry->id != first->id)
+    {
+      return -1;
+    }
+  }
+  return first->id;
+}
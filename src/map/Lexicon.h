@@ -0,0 +1,41 @@
+//
+// Created by Zoe on 10/11/2019.
+//
+
+#ifndef PROJECT_LEXICON_H
+#define PROJECT_LEXICON_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ *  Maps the words a player can type to IDs.
+ *  Words are added while the world loads, then compiled into a sorted
+ *  table. Looking a word up is a binary search over the table and never
+ *  allocates. A word can also be looked up by any prefix of it that no
+ *  other word shares, e.g. "INV" for "INVENTORY".
+ */
+class Lexicon
+{
+ public:
+  Lexicon() = default;
+  ~Lexicon() = default;
+
+  void add(const std::string& word, int id);
+  void compile();
+  void clear();
+
+  int find(const char* word, size_t length) const;
+
+ private:
+  struct Entry
+  {
+    std::string word;
+    int id;
+  };
+
+  std::vector<Entry> entries;
+};
+
+#endif // PROJECT_LEXICON_H
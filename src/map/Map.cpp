@@ -3,302 +3,270 @@
 //
 
 #include "Map.h"
-#include <Engine/FileIO.h>
-#include <iostream>
-#include <nlohmann/json.hpp>
 
-void Map::reset()
+namespace
 {
-  loadRooms();
-  loadObjects();
-
-  current_room = 57;
-
-  light_amount = 40;
-  light_ignited = false;
+const char* const DIRECTION_NAMES[DATA::DIRECTION_NUM] = {
+  "NORTH", "EAST",       "SOUTH",      "WEST",       "UP",
+  "DOWN",  "NORTH EAST", "NORTH WEST", "SOUTH EAST", "SOUTH WEST"
+};
 }
 
-void Map::loadRooms()
+std::string Map::lightCandle()
 {
-  using File = ASGE::FILEIO::File;
-  File file = File();
-
-  // Open file
-  if (file.open("/data/rooms.json", ASGE::FILEIO::File::IOMode::READ))
+  std::string response = "";
+  if (state.light_amount > 0)
   {
-    // Get file data
-    using Buffer = ASGE::FILEIO::IOBuffer;
-    Buffer buffer = file.read();
-    file.close();
-
-    // Read file data as JSON
-    auto file_data =
-      nlohmann::json::parse(buffer.as_char(), buffer.as_char() + buffer.length);
-
-    // Populate each room with it's information
-    for (const auto& room : file_data.items())
-    {
-      int id = room.value()["ID"];
-      std::string name = room.value()["Name"];
-      bool north = room.value()["Exits"][0];
-      bool east = room.value()["Exits"][1];
-      bool south = room.value()["Exits"][2];
-      bool west = room.value()["Exits"][3];
-      int items[5] = { room.value()["Items"][0],
-                       room.value()["Items"][1],
-                       room.value()["Items"][2],
-                       room.value()["Items"][3],
-                       room.value()["Items"][4] };
-      bool dark = room.value()["Dark"];
-
-      rooms[id].setup(id, &name, north, east, south, west, items, dark);
-    }
-
-    std::cout << "Loaded Rooms" << std::endl;
+    state.light_ignited = true;
+    revealObject(6);
+    response = "You light the candle.";
   }
   else
   {
-    std::cout << "Rooms file not found" << std::endl;
+    response = "You're candle has burnt out,\nyou can't light "
+               "it again.";
   }
+  return response;
 }
 
-void Map::loadObjects()
+void Map::unlightCandle()
 {
-  using File = ASGE::FILEIO::File;
-  File file = File();
-
-  // Open file
-  if (file.open("/data/objects.json", ASGE::FILEIO::File::IOMode::READ))
+  state.light_ignited = false;
+  if (journal != nullptr)
   {
-    // Get file data
-    using Buffer = ASGE::FILEIO::IOBuffer;
-    Buffer buffer = file.read();
-    file.close();
-
-    // Read file data as JSON
-    auto file_data =
-      nlohmann::json::parse(buffer.as_char(), buffer.as_char() + buffer.length);
-
-    // Populate each object with it's information
-    int treasure_count = 0;
-    for (const auto& object : file_data.items())
-    {
-      int id = object.value()["ID"];
-      std::string name = object.value()["Name"];
-      std::string description = object.value()["Description"];
-      bool carry = object.value()["Collectible"];
-      bool hide = object.value()["Hidden"];
-      bool treasure = object.value()["Treasure"];
-
-      if (treasure)
-      {
-        treasures[treasure_count] = id - 1;
-        treasure_count += 1;
-      }
-
-      objects[id - 1].setup(id, &name, &description, carry, hide, treasure);
-    }
-
-    std::cout << "Loaded Objects" << std::endl;
-  }
-  else
-  {
-    std::cout << "Objects file not found" << std::endl;
+    journal->hiddenChanged(6, state.hidden_objects[6]);
   }
+  state.hidden_objects[6] = 1;
+  state.revision += 1;
 }
 
-std::string Map::lightCandle()
+/**
+ *   @brief   Is an object in the current room
+ *   @param   object The object's index.
+ */
+bool Map::objectHere(int object) const
 {
-  std::string response = "";
-  if (light_amount > 0)
-  {
-    light_ignited = true;
-    objects[6].hidden(false);
-    response = "You light the candle.";
-  }
-  else
-  {
-    response = "You're candle has burnt out,\nyou can't light "
-               "it again.";
-  }
-  return response;
+  return state.object_location[object] == state.current_room;
 }
 
-void Map::unlightCandle()
+/**
+ *   @brief   Where an object is
+ *   @param   object The object's index.
+ *   @return  A room index, DATA::CARRIED or DATA::NOWHERE.
+ */
+int Map::objectLocation(int object) const
 {
-  light_ignited = false;
-  objects[6].hidden(true);
+  return state.object_location[object];
 }
 
-int Map::checkRoom(int object)
+/**
+ *   @brief   Moves an object, e.g. into the inventory or to a room
+ *   @details Objects moved into a room go after the objects already
+ *            there. A room can hold any number of objects.
+ *   @param   object The object's index.
+ *   @param   location A room index, DATA::CARRIED or DATA::NOWHERE.
+ */
+void Map::moveObject(int object, int location)
 {
-  for (int i = 0; i < 5; i++)
+  if (journal != nullptr)
   {
-    if (rooms[current_room].roomObjects()[i] == object)
-    {
-      return i;
-    }
+    journal->objectMoved(
+      object, state.object_location[object], state.object_prev[object]);
+  }
+  unlinkObject(object);
+  state.object_location[object] = location;
+  if (location >= 0)
+  {
+    linkObject(object, location, state.room_last[location]);
   }
-  return -1;
+  state.revision += 1;
 }
 
-void Map::removeObjectFromCurrentRoom(int index)
+/**
+ *   @brief   Moves an object to just after another in a room
+ *   @details Used to put an object back where it was. Isn't journaled.
+ *   @param   object The object's index.
+ *   @param   location A room index, DATA::CARRIED or DATA::NOWHERE.
+ *   @param   after The object to follow, or -1 to be first in the room.
+ */
+void Map::placeObject(int object, int location, int after)
 {
-  rooms[current_room].roomObjects()[index] = -1;
+  unlinkObject(object);
+  state.object_location[object] = location;
+  if (location >= 0)
+  {
+    linkObject(object, location, after);
+  }
+  state.revision += 1;
 }
 
-void Map::changeExits(int room, int dir, bool value)
+/**
+ *   @brief   The first object in a room, then use nextObject()
+ *   @return  The object's index, or -1 if the room is empty.
+ */
+int Map::firstObject(int room) const
 {
-  switch (dir)
-  {
-    case 0:
-      rooms[room].North(value);
-      break;
-    case 1:
-      rooms[room].East(value);
-      break;
-    case 2:
-      rooms[room].South(value);
-      break;
-    case 3:
-      rooms[room].West(value);
-      break;
-    default:
-      break;
-  }
+  return state.room_first[room];
 }
 
-void Map::revealObject(int index)
+/**
+ *   @brief   The object after this one in the same room
+ *   @return  The object's index, or -1 if it was the last.
+ */
+int Map::nextObject(int object) const
 {
-  objects[index].hidden(false);
+  return state.object_next[object];
 }
 
-std::string Map::moveNorth()
+void Map::unlinkObject(int object)
 {
-  std::string response = "";
-  if (rooms[current_room].North())
+  int room = state.object_location[object];
+  if (room < 0)
   {
-    if (!rooms[current_room - 8].needsLight() ||
-        (rooms[current_room - 8].needsLight() && light_ignited))
-    {
-      current_room -= 8;
-      response = "You move NORTH";
-
-      if (current_room == 41)
-      {
-        response = "The door slams shut behind you, and locks...";
-      }
+    return;
+  }
 
-      response += checkLight();
-    }
-    else
-    {
-      response = "You need a light to go NORTH";
-    }
+  int32_t prev = state.object_prev[object];
+  int32_t next = state.object_next[object];
+  if (prev == -1)
+  {
+    state.room_first[room] = next;
+  }
+  else
+  {
+    state.object_next[prev] = next;
+  }
+  if (next == -1)
+  {
+    state.room_last[room] = prev;
   }
   else
   {
-    response = "You can't go that way!";
+    state.object_prev[next] = prev;
   }
 
-  return response;
+  state.object_prev[object] = -1;
+  state.object_next[object] = -1;
 }
 
-std::string Map::moveEast()
+void Map::linkObject(int object, int room, int after)
 {
-  std::string response = "";
-  if (rooms[current_room].East())
+  int32_t next =
+    after == -1 ? state.room_first[room] : state.object_next[after];
+  state.object_prev[object] = after;
+  state.object_next[object] = next;
+  if (after == -1)
   {
-    if (!rooms[current_room + 1].needsLight() ||
-        (rooms[current_room + 1].needsLight() && light_ignited))
-    {
-      current_room += 1;
-      response = "You move EAST";
-      response += checkLight();
-    }
-    else
-    {
-      response = "You need a light to go EAST";
-    }
+    state.room_first[room] = object;
   }
   else
   {
-    response = "You can't go that way!";
+    state.object_next[after] = object;
+  }
+  if (next == -1)
+  {
+    state.room_last[room] = object;
+  }
+  else
+  {
+    state.object_prev[next] = object;
   }
-
-  return response;
 }
 
-std::string Map::moveSouth()
+void Map::changeExits(int room, int dir, bool value)
 {
-  std::string response = "";
-  if (rooms[current_room].South())
+  if (journal != nullptr)
   {
-    if (!rooms[current_room + 8].needsLight() ||
-        (rooms[current_room + 8].needsLight() && light_ignited))
-    {
-      current_room += 8;
-      response = "You move SOUTH";
-      response += checkLight();
-    }
-    else
-    {
-      response = "You need a light to go SOUTH";
-    }
+    journal->exitsChanged(room, state.exits[room]);
+  }
+  if (value)
+  {
+    state.exits[room] = static_cast<uint16_t>(state.exits[room] | 1 << dir);
   }
   else
   {
-    response = "You can't go that way!";
+    state.exits[room] = static_cast<uint16_t>(state.exits[room] & ~(1 << dir));
   }
+  state.revision += 1;
+}
 
-  return response;
+bool Map::hasExit(int room, int dir) const
+{
+  return (state.exits[room] & 1 << dir) != 0;
+}
+
+void Map::revealObject(int index)
+{
+  if (journal != nullptr)
+  {
+    journal->hiddenChanged(index, state.hidden_objects[index]);
+  }
+  state.hidden_objects[index] = 0;
+  state.revision += 1;
 }
 
-std::string Map::moveWest()
+bool Map::objectHidden(int index) const
+{
+  return state.hidden_objects[index] != 0;
+}
+
+/**
+ *   @brief   Moves the player through an exit
+ *   @details Every direction is handled the same way, the room the
+ *            exit leads to comes from the world's link table.
+ *   @param   direction See DATA::NORTH etc.
+ *   @return  The response to show the player.
+ */
+std::string Map::move(int direction)
 {
   std::string response = "";
-  if (rooms[current_room].West())
+  int target = data.link(state.current_room, direction);
+
+  if (!hasExit(state.current_room, direction) || target == -1)
   {
-    if (!rooms[current_room - 1].needsLight() ||
-        (rooms[current_room - 1].needsLight() && light_ignited))
+    if (direction == DATA::WEST && state.current_room == 45)
     {
-      current_room -= 1;
-      response = "You move WEST";
-      response += checkLight();
+      response = "There's a magical barrier blocking the way.\nUnless "
+                 "you know a magical spell,\nthere's no way out...";
     }
     else
     {
-      response = "You need a light to go WEST";
+      response = "You can't go that way!";
     }
   }
+  else if (data.room(target).needsLight() && !state.light_ignited)
+  {
+    response = "You need a light to go ";
+    response += DIRECTION_NAMES[direction];
+  }
   else
   {
-    if (current_room == 45)
+    state.current_room = target;
+    state.revision += 1;
+    if (direction == DATA::NORTH && state.current_room == 41)
     {
-      response = "There's a magical barrier blocking the way.\nUnless "
-                 "you know a magical spell,\nthere's no way out...";
+      response = "The door slams shut behind you, and locks...";
     }
     else
     {
-      response = "You can't go that way!";
+      response = "You move ";
+      response += DIRECTION_NAMES[direction];
     }
+    response += checkLight();
   }
-
   return response;
 }
 
 std::string Map::removeBats()
 {
   std::string response = "";
-  int index = checkRoom(23);
-
-  if (index == -1)
+  if (!objectHere(22))
   {
     response = "There are no bats in this room...";
   }
   else
   {
-    rooms[current_room].roomObjects()[index] = -1;
+    moveObject(22, DATA::NOWHERE);
     response = "You vanquish the bats!";
   }
   return response;
@@ -307,15 +275,13 @@ std::string Map::removeBats()
 std::string Map::removeGhosts()
 {
   std::string response = "";
-  int index = checkRoom(24);
-
-  if (index == -1)
+  if (!objectHere(23))
   {
     response = "There are no ghosts in this room...";
   }
   else
   {
-    rooms[current_room].roomObjects()[index] = -1;
+    moveObject(23, DATA::NOWHERE);
     response = "You vanquish the ghosts!";
   }
 
@@ -325,17 +291,17 @@ std::string Map::removeGhosts()
 std::string Map::checkLight()
 {
   std::string response = "";
-  if (light_ignited)
+  if (state.light_ignited)
   {
-    light_amount -= 1;
+    state.light_amount -= 1;
 
-    if (light_amount == 10)
+    if (state.light_amount == 10)
     {
       response = "\nYour light is beginning to flicker out...";
     }
-    else if (light_amount <= 0)
+    else if (state.light_amount <= 0)
     {
-      light_ignited = false;
+      state.light_ignited = false;
       response = "\nYour light went out!";
     }
   }
@@ -344,30 +310,37 @@ std::string Map::checkLight()
 
 void Map::magicRandomRoom()
 {
-  current_room = say_random_rooms[rand() % DATA::SAY_RANDOM_ROOM_NUM];
+  if (data.teleportCount() == 0)
+  {
+    return;
+  }
+
+  state.current_room = data.teleportRoom(static_cast<int>(
+    state.random_engine() % static_cast<unsigned>(data.teleportCount())));
+  state.revision += 1;
 }
 
-Room Map::room(int i)
+const Room& Map::room(int i) const
 {
-  return rooms[i];
+  return data.room(i);
 }
 
-Room Map::currentRoom()
+const Room& Map::currentRoom() const
 {
-  return rooms[current_room];
+  return data.room(state.current_room);
 }
 
-Object Map::object(int i)
+const Object& Map::object(int i) const
 {
-  return objects[i];
+  return data.object(i);
 }
 
-int Map::treasure(int i)
+int Map::treasure(int i) const
 {
-  return treasures[i];
+  return data.treasure(i);
 }
 
-bool Map::candleLit()
+bool Map::candleLit() const
 {
-  return light_ignited;
+  return state.light_ignited;
 }
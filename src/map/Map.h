@@ -6,30 +6,43 @@
 #define PROJECT_MAP_H
 
 #include "../game/GameConstants.h"
+#include "../session/Journal.h"
+#include "../session/SessionState.h"
 #include "Object.h"
 #include "Room.h"
+#include "WorldData.h"
+#include <string>
 
+/**
+ *  A session's view of the world.
+ *  Combines the shared WorldData with the session's own SessionState,
+ *  all changes are written to the session state. Changes to the
+ *  state's tables are also written to the journal, if there is one.
+ */
 class Map
 {
  public:
-  Map() = default;
+  Map(const WorldData& world_data,
+      SessionState& session_state,
+      Journal* session_journal = nullptr) :
+    data(world_data), state(session_state), journal(session_journal)
+  {
+  }
   ~Map() = default;
 
-  void reset();
-
-  void loadRooms();
-  void loadObjects();
-
-  int checkRoom(int object);
-  void removeObjectFromCurrentRoom(int index);
+  bool objectHere(int object) const;
+  int objectLocation(int object) const;
+  void moveObject(int object, int location);
+  void placeObject(int object, int location, int after);
+  int firstObject(int room) const;
+  int nextObject(int object) const;
 
   void changeExits(int room, int dir, bool value);
+  bool hasExit(int room, int dir) const;
   void revealObject(int index);
+  bool objectHidden(int index) const;
 
-  std::string moveNorth();
-  std::string moveEast();
-  std::string moveSouth();
-  std::string moveWest();
+  std::string move(int direction);
   std::string removeBats();
   std::string removeGhosts();
   std::string checkLight();
@@ -37,29 +50,20 @@ class Map
   void unlightCandle();
   void magicRandomRoom();
 
-  Room room(int i);
-  Room currentRoom();
-  Object object(int i);
+  const Room& room(int i) const;
+  const Room& currentRoom() const;
+  const Object& object(int i) const;
 
-  int treasure(int i);
-  int candleAmount();
-  bool candleLit();
+  int treasure(int i) const;
+  bool candleLit() const;
 
  private:
-  Room rooms[DATA::ROOM_NUM];
-  Object objects[DATA::OBJECT_NUM];
-  int treasures[DATA::TREASURE_NUM] = { -1 };
-
-  int current_room = 57;
-
-  int say_random_rooms[DATA::SAY_RANDOM_ROOM_NUM] = {
-    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 14,
-    15, 16, 17, 23, 24, 25, 31, 32, 33, 34, 39, 40, 41,
-    42, 43, 47, 48, 49, 56, 57, 58, 59, 60, 61, 62, 63
-  };
+  void unlinkObject(int object);
+  void linkObject(int object, int room, int after);
 
-  int light_amount = 40;
-  bool light_ignited = false;
+  const WorldData& data;
+  SessionState& state;
+  Journal* journal;
 };
 
 #endif // PROJECT_MAP_H
@@ -19,37 +19,32 @@ void Object::setup(int id,
   valuable = treasure;
 }
 
-int Object::objectID()
+int Object::objectID() const
 {
   return ID;
 }
 
-std::string Object::objectName()
+const std::string& Object::objectName() const
 {
   return name;
 }
 
-std::string Object::examine()
+const std::string& Object::examine() const
 {
   return description;
 }
 
-bool Object::collectible()
+bool Object::collectible() const
 {
   return can_pick_up;
 }
 
-bool Object::hidden()
+bool Object::startsHidden() const
 {
   return hiding;
 }
 
-bool Object::treasure()
+bool Object::treasure() const
 {
   return valuable;
 }
-
-void Object::hidden(bool hide)
-{
-  hiding = hide;
-}
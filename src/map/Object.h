@@ -7,6 +7,11 @@
 
 #include <string>
 
+/**
+ *  The read-only definition of an object.
+ *  Whether the object is currently hidden is kept per session in
+ *  SessionState.
+ */
 class Object
 {
  public:
@@ -20,14 +25,12 @@ class Object
              bool hide,
              bool treasure);
 
-  int objectID();
-  std::string objectName();
-  std::string examine();
-  bool collectible();
-  bool hidden();
-  bool treasure();
-
-  void hidden(bool hide);
+  int objectID() const;
+  const std::string& objectName() const;
+  const std::string& examine() const;
+  bool collectible() const;
+  bool startsHidden() const;
+  bool treasure() const;
 
  private:
   int ID;
@@ -0,0 +1,718 @@
+//
+// Created by Zoe on 19/11/2019.
+//
+
+#include "RecordReader.h"
+#include <climits>
+#include <cstring>
+
+namespace
+{
+// values nested deeper than this inside a record are rejected
+const int MAX_DEPTH = 64;
+
+const char UTF8_BOM[] = "\xEF\xBB\xBF";
+
+void appendUtf8(std::string* text, uint32_t code)
+{
+  if (code < 0x80)
+  {
+    text->push_back(static_cast<char>(code));
+  }
+  else if (code < 0x800)
+  {
+    text->push_back(static_cast<char>(0xC0 | (code >> 6)));
+    text->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+  else if (code < 0x10000)
+  {
+    text->push_back(static_cast<char>(0xE0 | (code >> 12)));
+    text->push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    text->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+  else
+  {
+    text->push_back(static_cast<char>(0xF0 | (code >> 18)));
+    text->push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+    text->push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    text->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+}
+}
+
+/**
+ *   @param   field_names The fields to keep, e.g. "ID". A field is
+ *            then referred to by its index in the list.
+ */
+RecordReader::RecordReader(const std::vector<std::string>& field_names)
+{
+  fields.resize(field_names.size());
+  for (size_t i = 0; i < field_names.size(); i++)
+  {
+    fields[i].name = field_names[i];
+  }
+}
+
+/**
+ *   @brief   Reads every record in a file
+ *   @details on_record is called once each record has been read, and
+ *            reads the record's fields. Reading stops at the first
+ *            error, either in the file or found by on_record.
+ *   @param   json The file's contents.
+ *   @param   length The size of the file in bytes.
+ *   @param   on_record Called with each record.
+ *   @return  False if there was an error, see error().
+ */
+bool RecordReader::read(const char* json,
+                        size_t length,
+                        const Handler& on_record)
+{
+  next = json;
+  end = json + length;
+  line = 1;
+  message.clear();
+
+  const size_t bom_length = sizeof(UTF8_BOM) - 1;
+  if (length >= bom_length && std::memcmp(json, UTF8_BOM, bom_length) == 0)
+  {
+    next += bom_length;
+  }
+
+  skipSpace();
+  if (!expect('[', "a list of records"))
+  {
+    return false;
+  }
+
+  skipSpace();
+  if (peek() == ']')
+  {
+    next += 1;
+  }
+  else
+  {
+    while (true)
+    {
+      if (!readRecord())
+      {
+        return false;
+      }
+      on_record();
+      if (!message.empty())
+      {
+        return false;
+      }
+
+      skipSpace();
+      if (peek() == ']')
+      {
+        next += 1;
+        break;
+      }
+      if (!expect(',', "',' or ']' after a record"))
+      {
+        return false;
+      }
+      skipSpace();
+    }
+  }
+
+  skipSpace();
+  if (next != end)
+  {
+    return fail(line, "unexpected text after the list of records");
+  }
+  return true;
+}
+
+/**
+ *   @brief   The first error found, with its line, e.g.
+ *            "line 12: \"Items\" must be a list of whole numbers"
+ */
+const std::string& RecordReader::error() const
+{
+  return message;
+}
+
+/**
+ *   @brief   The line the record being handed over starts on
+ */
+int RecordReader::recordLine() const
+{
+  return record_line;
+}
+
+/**
+ *   @brief   Whether the record has a field, for optional fields
+ */
+bool RecordReader::has(int field) const
+{
+  return fields[static_cast<size_t>(field)].type != Type::MISSING;
+}
+
+/**
+ *   @brief   A field holding a whole number
+ *   @details Fails the read if the field is missing or isn't a whole
+ *            number, as do the other field accessors.
+ */
+int RecordReader::integer(int field)
+{
+  Field* value = present(field);
+  if (value == nullptr)
+  {
+    return 0;
+  }
+  if (value->type != Type::NUMBER)
+  {
+    wrongType(*value, "a whole number");
+    return 0;
+  }
+  return value->number;
+}
+
+bool RecordReader::flag(int field)
+{
+  Field* value = present(field);
+  if (value == nullptr)
+  {
+    return false;
+  }
+  if (value->type != Type::BOOLEAN)
+  {
+    wrongType(*value, "true or false");
+    return false;
+  }
+  return value->number != 0;
+}
+
+const std::string& RecordReader::text(int field)
+{
+  Field* value = present(field);
+  if (value == nullptr)
+  {
+    return key;
+  }
+  if (value->type != Type::STRING)
+  {
+    wrongType(*value, "a string");
+  }
+  return value->text;
+}
+
+int RecordReader::listSize(int field)
+{
+  Field* value = present(field);
+  if (value == nullptr)
+  {
+    return 0;
+  }
+  if (value->type != Type::LIST)
+  {
+    wrongType(*value, "a list");
+    return 0;
+  }
+  return static_cast<int>(value->list.size());
+}
+
+/**
+ *   @param   field The list.
+ *   @param   i The item, less than listSize().
+ */
+int RecordReader::listInteger(int field, int i)
+{
+  const Field& value = fields[static_cast<size_t>(field)];
+  const Value& item = value.list[static_cast<size_t>(i)];
+  if (item.type != Type::NUMBER)
+  {
+    wrongType(value, "a list of whole numbers");
+    return 0;
+  }
+  return item.number;
+}
+
+/**
+ *   @param   field The list.
+ *   @param   i The item, less than listSize().
+ */
+bool RecordReader::listFlag(int field, int i)
+{
+  const Field& value = fields[static_cast<size_t>(field)];
+  const Value& item = value.list[static_cast<size_t>(i)];
+  if (item.type != Type::BOOLEAN)
+  {
+    wrongType(value, "a list of true or false");
+    return false;
+  }
+  return item.number != 0;
+}
+
+/**
+ *   @brief   Fails the read because a field isn't what was expected
+ *   @param   field The field.
+ *   @param   expected What it should be, e.g. "a list of 5 object IDs".
+ */
+void RecordReader::reject(int field, const char* expected)
+{
+  wrongType(fields[static_cast<size_t>(field)], expected);
+}
+
+bool RecordReader::readRecord()
+{
+  if (!expect('{', "a record"))
+  {
+    return false;
+  }
+  record_line = line;
+  for (auto& field : fields)
+  {
+    field.type = Type::MISSING;
+  }
+
+  skipSpace();
+  if (peek() == '}')
+  {
+    next += 1;
+    return true;
+  }
+
+  while (true)
+  {
+    if (!expect('"', "a field name") || !readString(&key))
+    {
+      return false;
+    }
+    skipSpace();
+    if (!expect(':', "':' after a field name"))
+    {
+      return false;
+    }
+    skipSpace();
+
+    Field* field = nullptr;
+    for (auto& known : fields)
+    {
+      if (known.name == key)
+      {
+        field = &known;
+        break;
+      }
+    }
+    if (!(field != nullptr ? readField(field) : skipValue(1)))
+    {
+      return false;
+    }
+
+    skipSpace();
+    if (peek() == '}')
+    {
+      next += 1;
+      return true;
+    }
+    if (!expect(',', "',' or '}' after a field"))
+    {
+      return false;
+    }
+    skipSpace();
+  }
+}
+
+bool RecordReader::readField(Field* field)
+{
+  field->line = line;
+  if (peek() != '[')
+  {
+    Value value = {};
+    if (!readValue(&value, &field->text, 1))
+    {
+      return false;
+    }
+    field->type = value.type;
+    field->number = value.number;
+    return true;
+  }
+
+  next += 1;
+  field->type = Type::LIST;
+  field->list.clear();
+  skipSpace();
+  if (peek() == ']')
+  {
+    next += 1;
+    return true;
+  }
+
+  while (true)
+  {
+    Value item = {};
+    if (!readValue(&item, &skipped, 2))
+    {
+      return false;
+    }
+    field->list.push_back(item);
+
+    skipSpace();
+    if (peek() == ']')
+    {
+      next += 1;
+      return true;
+    }
+    if (!expect(',', "',' or ']' in a list"))
+    {
+      return false;
+    }
+    skipSpace();
+  }
+}
+
+/**
+ *   @brief   Reads a value, objects and lists are skipped
+ */
+bool RecordReader::readValue(Value* value, std::string* text, int depth)
+{
+  switch (peek())
+  {
+    case '"':
+      next += 1;
+      value->type = Type::STRING;
+      return readString(text);
+    case 't':
+      value->type = Type::BOOLEAN;
+      value->number = 1;
+      return readWord("true");
+    case 'f':
+      value->type = Type::BOOLEAN;
+      value->number = 0;
+      return readWord("false");
+    case 'n':
+      value->type = Type::OTHER;
+      return readWord("null");
+    case '[':
+    case '{':
+      value->type = Type::OTHER;
+      return skipValue(depth);
+    default:
+      return readNumber(value);
+  }
+}
+
+/**
+ *   @brief   Reads a string, after its opening quote
+ */
+bool RecordReader::readString(std::string* text)
+{
+  text->clear();
+  while (true)
+  {
+    const char* run = next;
+    while (next != end && *next != '"' && *next != '\\' &&
+           static_cast<unsigned char>(*next) >= 0x20)
+    {
+      next += 1;
+    }
+    text->append(run, static_cast<size_t>(next - run));
+
+    if (next == end)
+    {
+      return fail(line, "a string isn't closed");
+    }
+    if (*next == '"')
+    {
+      next += 1;
+      return true;
+    }
+    if (*next != '\\')
+    {
+      return fail(line, "a string has a control character in it");
+    }
+
+    next += 1;
+    if (next == end)
+    {
+      return fail(line, "a string isn't closed");
+    }
+    const char escaped = *next;
+    next += 1;
+    switch (escaped)
+    {
+      case '"':
+      case '\\':
+      case '/':
+        text->push_back(escaped);
+        break;
+      case 'b':
+        text->push_back('\b');
+        break;
+      case 'f':
+        text->push_back('\f');
+        break;
+      case 'n':
+        text->push_back('\n');
+        break;
+      case 'r':
+        text->push_back('\r');
+        break;
+      case 't':
+        text->push_back('\t');
+        break;
+      case 'u':
+      {
+        uint32_t code = 0;
+        if (!readHex(&code))
+        {
+          return false;
+        }
+        // characters past 0xFFFF are written as a pair of surrogates
+        if (code >= 0xD800 && code <= 0xDBFF)
+        {
+          uint32_t low = 0;
+          if (!readWord("\\u") || !readHex(&low) || low < 0xDC00 ||
+              low > 0xDFFF)
+          {
+            return fail(line, "a string has an unpaired surrogate");
+          }
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        }
+        else if (code >= 0xDC00 && code <= 0xDFFF)
+        {
+          return fail(line, "a string has an unpaired surrogate");
+        }
+        appendUtf8(text, code);
+        break;
+      }
+      default:
+        return fail(line, "a string has an unknown escape");
+    }
+  }
+}
+
+bool RecordReader::readNumber(Value* value)
+{
+  const bool negative = peek() == '-';
+  if (negative)
+  {
+    next += 1;
+  }
+  if (peek() < '0' || peek() > '9')
+  {
+    return fail(line, "expected a value");
+  }
+
+  // kept negative, as INT_MIN has no positive
+  int64_t number = 0;
+  bool fits = true;
+  while (peek() >= '0' && peek() <= '9')
+  {
+    number = number * 10 - (*next - '0');
+    fits = fits && number >= INT_MIN;
+    number = fits ? number : 0;
+    next += 1;
+  }
+
+  bool whole = true;
+  if (peek() == '.')
+  {
+    whole = false;
+    next += 1;
+    if (peek() < '0' || peek() > '9')
+    {
+      return fail(line, "a number has no digits after its '.'");
+    }
+    while (peek() >= '0' && peek() <= '9')
+    {
+      next += 1;
+    }
+  }
+  if (peek() == 'e' || peek() == 'E')
+  {
+    whole = false;
+    next += 1;
+    if (peek() == '+' || peek() == '-')
+    {
+      next += 1;
+    }
+    if (peek() < '0' || peek() > '9')
+    {
+      return fail(line, "a number has no digits in its exponent");
+    }
+    while (peek() >= '0' && peek() <= '9')
+    {
+      next += 1;
+    }
+  }
+
+  fits = fits && (negative || number >= -INT_MAX);
+  value->type = whole && fits ? Type::NUMBER : Type::FRACTION;
+  value->number = value->type == Type::NUMBER
+                    ? static_cast<int>(negative ? number : -number)
+                    : 0;
+  return true;
+}
+
+bool RecordReader::readWord(const char* word)
+{
+  const size_t length = std::strlen(word);
+  if (static_cast<size_t>(end - next) < length ||
+      std::memcmp(next, word, length) != 0)
+  {
+    return fail(line, "expected a value");
+  }
+  next += length;
+  return true;
+}
+
+bool RecordReader::readHex(uint32_t* code)
+{
+  *code = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    const char digit = peek();
+    uint32_t nibble = 0;
+    if (digit >= '0' && digit <= '9')
+    {
+      nibble = static_cast<uint32_t>(digit - '0');
+    }
+    else if (digit >= 'a' && digit <= 'f')
+    {
+      nibble = static_cast<uint32_t>(digit - 'a' + 10);
+    }
+    else if (digit >= 'A' && digit <= 'F')
+    {
+      nibble = static_cast<uint32_t>(digit - 'A' + 10);
+    }
+    else
+    {
+      return fail(line, "a \\u escape needs four hex digits");
+    }
+    *code = *code << 4 | nibble;
+    next += 1;
+  }
+  return true;
+}
+
+/**
+ *   @brief   Reads past a value that isn't kept
+ */
+bool RecordReader::skipValue(int depth)
+{
+  const char open = peek();
+  if (open != '[' && open != '{')
+  {
+    Value value = {};
+    return readValue(&value, &skipped, depth);
+  }
+  if (depth >= MAX_DEPTH)
+  {
+    return fail(line, "values are nested too deeply");
+  }
+
+  const char close = open == '[' ? ']' : '}';
+  next += 1;
+  skipSpace();
+  if (peek() == close)
+  {
+    next += 1;
+    return true;
+  }
+
+  while (true)
+  {
+    if (open == '{')
+    {
+      if (!expect('"', "a field name") || !readString(&skipped))
+      {
+        return false;
+      }
+      skipSpace();
+      if (!expect(':', "':' after a field name"))
+      {
+        return false;
+      }
+      skipSpace();
+    }
+    if (!skipValue(depth + 1))
+    {
+      return false;
+    }
+
+    skipSpace();
+    if (peek() == close)
+    {
+      next += 1;
+      return true;
+    }
+    if (!expect(',', open == '[' ? "',' or ']' in a list"
+                                 : "',' or '}' after a field"))
+    {
+      return false;
+    }
+    skipSpace();
+  }
+}
+
+void RecordReader::skipSpace()
+{
+  while (next != end)
+  {
+    switch (*next)
+    {
+      case '\n':
+        line += 1;
+        next += 1;
+        break;
+      case ' ':
+      case '\t':
+      case '\r':
+        next += 1;
+        break;
+      default:
+        return;
+    }
+  }
+}
+
+/**
+ *   @brief   The next character, or 0 at the end of the file
+ */
+char RecordReader::peek() const
+{
+  return next != end ? *next : '\0';
+}
+
+bool RecordReader::expect(char symbol, const char* what)
+{
+  if (peek() != symbol)
+  {
+    return fail(line, std::string("expected ") + what);
+  }
+  next += 1;
+  return true;
+}
+
+RecordReader::Field* RecordReader::present(int field)
+{
+  Field& value = fields[static_cast<size_t>(field)];
+  if (value.type == Type::MISSING)
+  {
+    fail(record_line, "a record has no \"" + value.name + "\"");
+    return nullptr;
+  }
+  return &value;
+}
+
+/**
+ *   @brief   Keeps the first error found
+ *   @return  False, to return from the reader.
+ */
+bool RecordReader::fail(int at_line, const std::string& problem)
+{
+  if (message.empty())
+  {
+    message = "line " + std::to_string(at_line) + ": " + problem;
+  }
+  return false;
+}
+
+bool RecordReader::wrongType(const Field& field, const char* expected)
+{
+  return fail(field.line, "\"" + field.name + "\" must be " + expected);
+}
@@ -0,0 +1,99 @@
+//
+// Created by Zoe on 19/11/2019.
+//
+
+#ifndef PROJECT_RECORDREADER_H
+#define PROJECT_RECORDREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ *  Reads a JSON list of records, e.g. rooms.json, in a single pass.
+ *  Each record is an object of named fields holding numbers, booleans,
+ *  strings or lists of them. Only the fields the reader was made with
+ *  are kept, everything else is skipped, and each record is handed
+ *  over as soon as it has been read. The fields are reused from one
+ *  record to the next, so the memory used doesn't grow with the file.
+ *  Errors, including a field of the wrong type, give their line.
+ */
+class RecordReader
+{
+ public:
+  using Handler = std::function<void()>;
+
+  explicit RecordReader(const std::vector<std::string>& field_names);
+  ~RecordReader() = default;
+
+  bool read(const char* json, size_t length, const Handler& on_record);
+  const std::string& error() const;
+  int recordLine() const;
+
+  bool has(int field) const;
+  int integer(int field);
+  bool flag(int field);
+  const std::string& text(int field);
+  int listSize(int field);
+  int listInteger(int field, int i);
+  bool listFlag(int field, int i);
+  void reject(int field, const char* expected);
+
+ private:
+  enum class Type
+  {
+    MISSING,
+    NUMBER,   /**< A whole number that fits in an int. */
+    FRACTION, /**< Any other number. */
+    BOOLEAN,
+    STRING,
+    LIST,
+    OTHER /**< Null, or an object or list that was skipped. */
+  };
+
+  struct Value
+  {
+    Type type;
+    int number; /**< The number, or 1 for true. */
+  };
+
+  struct Field
+  {
+    std::string name;
+    Type type = Type::MISSING;
+    int number = 0;
+    std::string text;
+    std::vector<Value> list;
+    int line = 0;
+  };
+
+  bool readRecord();
+  bool readField(Field* field);
+  bool readValue(Value* value, std::string* text, int depth);
+  bool readString(std::string* text);
+  bool readNumber(Value* value);
+  bool readWord(const char* word);
+  bool readHex(uint32_t* code);
+  bool skipValue(int depth);
+  void skipSpace();
+  char peek() const;
+  bool expect(char symbol, const char* what);
+
+  Field* present(int field);
+  bool fail(int at_line, const std::string& problem);
+  bool wrongType(const Field& field, const char* expected);
+
+  std::vector<Field> fields;
+  std::string key = "";
+  std::string skipped = ""; /**< Strings that aren't kept. */
+
+  const char* next = nullptr;
+  const char* end = nullptr;
+  int line = 1;
+  int record_line = 1;
+  std::string message = "";
+};
+
+#endif // PROJECT_RECORDREADER_H
@@ -6,84 +6,75 @@
 
 void Room::setup(int id,
                  const std::string* descriptor,
-                 bool north,
-                 bool east,
-                 bool south,
-                 bool west,
-                 int room_objects[5],
-                 bool dark)
+                 int open_exits,
+                 const int exit_links[DATA::DIRECTION_NUM],
+                 int room_objects[DATA::ROOM_ITEM_NUM],
+                 bool dark,
+                 bool teleport_target)
 {
   ID = id;
   name = *descriptor;
-  // directions.setup(north, east, south, west);
-  this->north = north;
-  this->east = east;
-  this->south = south;
-  this->west = west;
+  exits = open_exits;
   this->dark = dark;
+  teleport = teleport_target;
 
-  for (int i = 0; i < 5; i++)
+  for (int i = 0; i < DATA::DIRECTION_NUM; i++)
   {
-    items[i] = room_objects[i];
+    links[i] = exit_links[i];
   }
-}
 
-bool Room::North()
-{
-  return north;
-}
-
-bool Room::East()
-{
-  return east;
-}
-
-bool Room::South()
-{
-  return south;
-}
-
-bool Room::West()
-{
-  return west;
-}
-
-void Room::North(bool n_exit)
-{
-  north = n_exit;
+  for (int i = 0; i < DATA::ROOM_ITEM_NUM; i++)
+  {
+    items[i] = room_objects[i];
+  }
 }
 
-void Room::East(bool e_exit)
+int Room::roomID() const
 {
-  east = e_exit;
+  return ID;
 }
 
-void Room::South(bool s_exit)
+const std::string& Room::roomName() const
 {
-  south = s_exit;
+  return name;
 }
 
-void Room::West(bool w_exit)
+bool Room::needsLight() const
 {
-  west = w_exit;
+  return dark;
 }
 
-int Room::roomID()
+/**
+ *   @brief   Can the SAY spell send the player here
+ */
+bool Room::teleportTarget() const
 {
-  return ID;
+  return teleport;
 }
 
-std::string Room::roomName()
+/**
+ *   @brief   The exits open at the start of the game
+ *   @details An exit can be opened or closed during the game.
+ *   @return  One bit per direction, see DATA::NORTH etc.
+ */
+int Room::startingExits() const
 {
-  return name;
+  return exits;
 }
 
-bool Room::needsLight()
+/**
+ *   @brief   The room an exit leads to
+ *   @details Links only go one way, the room at the other end needs
+ *            its own link back.
+ *   @param   direction See DATA::NORTH etc.
+ *   @return  The room's ID, or -1 if there is no exit that way.
+ */
+int Room::link(int direction) const
 {
-  return dark;
+  return links[direction];
 }
 
-int* Room::roomObjects()
+const int* Room::startingObjects() const
 {
   return items;
-}
\ No newline at end of file
+}
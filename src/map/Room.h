@@ -5,8 +5,14 @@
 #ifndef PROJECT_ROOM_H
 #define PROJECT_ROOM_H
 
+#include "../game/GameConstants.h"
 #include <string>
 
+/**
+ *  The read-only definition of a room.
+ *  The exits and items are the room's starting layout, the live values
+ *  are kept per session in SessionState.
+ */
 class Room
 {
  public:
@@ -15,37 +21,29 @@ class Room
 
   void setup(int id,
              const std::string* descriptor,
-             bool north,
-             bool east,
-             bool south,
-             bool west,
-             int room_objects[5],
-             bool dark);
-
-  int roomID();
-  std::string roomName();
-  bool needsLight();
-  bool North();
-  bool East();
-  bool South();
-  bool West();
-
-  void North(bool n_exit);
-  void East(bool e_exit);
-  void South(bool s_exit);
-  void West(bool w_exit);
-
-  int* roomObjects();
+             int open_exits,
+             const int exit_links[DATA::DIRECTION_NUM],
+             int room_objects[DATA::ROOM_ITEM_NUM],
+             bool dark,
+             bool teleport_target);
+
+  int roomID() const;
+  const std::string& roomName() const;
+  bool needsLight() const;
+  bool teleportTarget() const;
+
+  int startingExits() const;
+  int link(int direction) const;
+  const int* startingObjects() const;
 
  private:
   int ID = 0;
   std::string name = "";
-  bool north = false;
-  bool east = false;
-  bool south = false;
-  bool west = false;
-  int items[5];
-  bool dark;
+  int exits = 0;
+  int links[DATA::DIRECTION_NUM];
+  int items[DATA::ROOM_ITEM_NUM];
+  bool dark = false;
+  bool teleport = false;
 };
 
 #endif // PROJECT_ROOM_H
@@ -0,0 +1,132 @@
+//
+// Created by Zoe on 13/11/2019.
+//
+
+#include "RoomGenerator.h"
+#include "../game/GameConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+const int OPEN_CHANCE = 60;     /**< Percent of grid exits left open. */
+const int DARK_CHANCE = 10;     /**< Percent of rooms that need a light. */
+const int TELEPORT_CHANCE = 50; /**< Percent of rooms SAY can reach. */
+
+bool chance(std::mt19937* random, int percent)
+{
+  return static_cast<int>((*random)() % 100) < percent;
+}
+
+void appendFlag(std::string* json, bool value)
+{
+  json->append(value ? "true" : "false");
+}
+
+/**
+ *   @brief   Puts an object in the first free item slot of a room
+ *   @return  False if the room is full.
+ */
+bool placeObject(std::vector<int>* items, int room, int object)
+{
+  for (int i = 0; i < DATA::ROOM_ITEM_NUM; i++)
+  {
+    int& slot = (*items)[static_cast<size_t>(room * DATA::ROOM_ITEM_NUM + i)];
+    if (slot == -1)
+    {
+      slot = object;
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+/**
+ *   @brief   Generates the rooms of a world
+ *   @details Each room links to its neighbours on the grid and an
+ *            open exit is open from both sides. Every object is placed
+ *            in a random room.
+ *   @param   room_count The number of rooms, at least MIN_ROOMS.
+ *   @param   object_count The number of objects in objects.json.
+ *   @param   seed Seeds the layout.
+ *   @return  The rooms as a rooms.json document.
+ */
+std::string GENERATOR::rooms(int room_count, int object_count, uint32_t seed)
+{
+  room_count = std::max(room_count, MIN_ROOMS);
+  const int width =
+    static_cast<int>(std::ceil(std::sqrt(static_cast<double>(room_count))));
+  std::mt19937 random(seed);
+
+  // the walls to the east and south of each room, an exit is open when
+  // the wall it goes through is
+  std::vector<uint8_t> east_open(static_cast<size_t>(room_count));
+  std::vector<uint8_t> south_open(static_cast<size_t>(room_count));
+  for (int i = 0; i < room_count; i++)
+  {
+    east_open[i] = chance(&random, OPEN_CHANCE) ? 1 : 0;
+    south_open[i] = chance(&random, OPEN_CHANCE) ? 1 : 0;
+  }
+
+  std::vector<int> items(
+    static_cast<size_t>(room_count) * DATA::ROOM_ITEM_NUM, -1);
+  for (int object = 1; object <= object_count; object++)
+  {
+    int room = static_cast<int>(random() % static_cast<uint32_t>(room_count));
+    while (!placeObject(&items, room, object))
+    {
+      room = (room + 1) % room_count;
+    }
+  }
+
+  std::string json = "[\n";
+  for (int id = 0; id < room_count; id++)
+  {
+    int links[DATA::DIRECTION_NUM];
+    std::fill(links, links + DATA::DIRECTION_NUM, -1);
+    links[DATA::NORTH] = id >= width ? id - width : -1;
+    links[DATA::EAST] = (id + 1) % width != 0 && id + 1 < room_count ? id + 1
+                                                                      : -1;
+    links[DATA::SOUTH] = id + width < room_count ? id + width : -1;
+    links[DATA::WEST] = id % width != 0 ? id - 1 : -1;
+
+    bool exits[DATA::DIRECTION_NUM] = {};
+    exits[DATA::NORTH] =
+      links[DATA::NORTH] != -1 && south_open[links[DATA::NORTH]] != 0;
+    exits[DATA::EAST] = links[DATA::EAST] != -1 && east_open[id] != 0;
+    exits[DATA::SOUTH] = links[DATA::SOUTH] != -1 && south_open[id] != 0;
+    exits[DATA::WEST] =
+      links[DATA::WEST] != -1 && east_open[links[DATA::WEST]] != 0;
+
+    json.append("{\"ID\":").append(std::to_string(id));
+    json.append(",\"Name\":\"ROOM ").append(std::to_string(id));
+    json.append("\",\"Exits\":[");
+    for (int i = 0; i < DATA::DIRECTION_NUM; i++)
+    {
+      json.append(i == 0 ? "" : ",");
+      appendFlag(&json, exits[i]);
+    }
+    json.append("],\"Links\":[");
+    for (int i = 0; i < DATA::DIRECTION_NUM; i++)
+    {
+      json.append(i == 0 ? "" : ",").append(std::to_string(links[i]));
+    }
+    json.append("],\"Items\":[");
+    for (int i = 0; i < DATA::ROOM_ITEM_NUM; i++)
+    {
+      json.append(i == 0 ? "" : ",");
+      json.append(std::to_string(
+        items[static_cast<size_t>(id * DATA::ROOM_ITEM_NUM + i)]));
+    }
+    json.append("],\"Dark\":");
+    appendFlag(&json, chance(&random, DARK_CHANCE));
+    json.append(",\"Teleport\":");
+    appendFlag(&json, chance(&random, TELEPORT_CHANCE));
+    json.append(id + 1 < room_count ? "},\n" : "}\n");
+  }
+  json.append("]\n");
+  return json;
+}
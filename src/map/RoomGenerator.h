@@ -0,0 +1,25 @@
+//
+// Created by Zoe on 13/11/2019.
+//
+
+#ifndef PROJECT_ROOMGENERATOR_H
+#define PROJECT_ROOMGENERATOR_H
+
+#include "../game/GameConstants.h"
+#include <cstdint>
+#include <string>
+
+/**
+ *  Generates worlds of any size for testing and benchmarking.
+ *  Rooms are laid out on a square grid and written in the same format
+ *  as rooms.json, so they load with the game's own objects and actions.
+ *  The same seed always gives the same world.
+ */
+namespace GENERATOR
+{
+const int MIN_ROOMS = DATA::RULE_ROOM_NUM;
+
+std::string rooms(int room_count, int object_count, uint32_t seed);
+};
+
+#endif // PROJECT_ROOMGENERATOR_H
@@ -0,0 +1,1011 @@
+//
+// Created by Zoe on 06/11/2019.
+//
+
+#include "WorldData.h"
+#include "../session/Profiler.h"
+#include "RecordReader.h"
+#include "WorldImage.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+template<typename Record>
+bool validTable(uint32_t offset, size_t count, size_t size)
+{
+  return offset % alignof(Record) == 0 &&
+         offset + sizeof(Record) * count <= size;
+}
+
+template<typename Record>
+const Record* imageTable(const char* image, uint32_t offset)
+{
+  return reinterpret_cast<const Record*>(image + offset);
+}
+
+const char* const VERB_SYNONYMS[][2] = {
+  { "NORTH", "N" }, { "EAST", "E" }, { "SOUTH", "S" }, { "WEST", "W" },
+  { "UP", "U" },    { "DOWN", "D" }
+};
+
+/** The verb for moving in each direction, see DATA::NORTH etc. */
+const char* const DIRECTION_VERBS[DATA::DIRECTION_NUM] = { "N",  "E",  "S",
+                                                           "W",  "U",  "D",
+                                                           "NE", "NW", "SE",
+                                                           "SW" };
+
+const int GRID_WIDTH = 8;
+
+/**
+ *   @brief   The room next to another on the original map grid
+ *   @param   room The room's ID.
+ *   @param   direction See DATA::NORTH etc.
+ *   @param   room_count The number of rooms in the world.
+ *   @return  The room's ID, or -1 if there's none that way.
+ */
+int gridLink(int room, int direction, int room_count)
+{
+  const int offsets[] = { -GRID_WIDTH, 1, GRID_WIDTH, -1 };
+  if (direction > DATA::WEST)
+  {
+    return -1;
+  }
+
+  int link = room + offsets[direction];
+  return link >= 0 && link < room_count ? link : -1;
+}
+
+std::string imageString(const IMAGE::Header& header,
+                        const char* image,
+                        IMAGE::StringRef ref)
+{
+  if (ref.offset + static_cast<size_t>(ref.length) > header.strings_size)
+  {
+    return std::string();
+  }
+  return std::string(image + header.strings_offset + ref.offset, ref.length);
+}
+
+/**
+ *   @brief   Moves records read in file order to the index their ID gives
+ *   @details The IDs must run from the first ID with no gaps or
+ *            repeats, otherwise the first record out of range or
+ *            repeated is reported with its line and nothing is moved.
+ *            Nothing is moved either when every record is already in
+ *            place, as in the game's files.
+ *   @param   records The records, in the order they were read.
+ *   @param   lines The line each record starts on.
+ *   @param   first_id The ID of the first record, 0 or 1.
+ *   @param   file_name The file read, for the report, e.g. "rooms.json".
+ *   @param   kind The kind of record, for the report, e.g. "Room".
+ *   @param   id_of Gives a record's ID.
+ *   @return  False if the IDs don't give every record its own index.
+ */
+template<typename Record, typename IdOf>
+bool placeRecords(std::vector<Record>* records,
+                  const std::vector<int>& lines,
+                  int first_id,
+                  const char* file_name,
+                  const char* kind,
+                  IdOf id_of)
+{
+  const int count = static_cast<int>(records->size());
+  int in_place = 0;
+  while (in_place < count &&
+         id_of((*records)[in_place]) - first_id == in_place)
+  {
+    in_place += 1;
+  }
+  if (in_place == count)
+  {
+    return true;
+  }
+
+  // the line of the record at each index, 0 until one is found
+  std::vector<int> placed_lines(records->size(), 0);
+  for (int i = 0; i < count; i++)
+  {
+    const int id = id_of((*records)[i]);
+    const int index = id - first_id;
+    const int line = lines[i];
+    if (index < 0 || index >= count)
+    {
+      std::cout << file_name << " line " << line << ": " << kind << " " << id
+                << " is out of range, IDs must run from " << first_id
+                << " to " << first_id + count - 1 << std::endl;
+      return false;
+    }
+    if (placed_lines[index] != 0)
+    {
+      std::cout << file_name << " line " << line << ": " << kind << " " << id
+                << " is already on line " << placed_lines[index] << std::endl;
+      return false;
+    }
+    placed_lines[index] = line;
+  }
+
+  std::vector<Record> placed(records->size());
+  for (auto& record : *records)
+  {
+    placed[id_of(record) - first_id] = std::move(record);
+  }
+  records->swap(placed);
+  return true;
+}
+
+/**
+ *   @brief   Adds an object to the end of a room's list
+ */
+void linkLast(SessionState* state, int object, int room)
+{
+  int32_t last = state->room_last[room];
+  state->object_location[object] = room;
+  state->object_prev[object] = last;
+  state->object_next[object] = -1;
+  if (last == -1)
+  {
+    state->room_first[room] = object;
+  }
+  else
+  {
+    state->object_next[last] = object;
+  }
+  state->room_last[room] = object;
+}
+
+/**
+ *   @brief   Is an image built from the JSON files there are now
+ *   @details An image shipped without its JSON files is all there is,
+ *            so it is used as it is.
+ */
+bool imageIsCurrent(const DATA::FileBuffer& image,
+                    const DATA::FileReader& read_file)
+{
+  IMAGE::Header header = {};
+  uint32_t source_hash = 0;
+  if (image.size() < sizeof(header) ||
+      !IMAGE::sourceHash(read_file, &source_hash))
+  {
+    return true;
+  }
+
+  std::memcpy(&header, image.data(), sizeof(header));
+  if (header.source_hash != source_hash)
+  {
+    std::cout << "World image is out of date" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+/**
+ *   @brief   Loads the world
+ *   @details Uses the compiled world image when there is a valid one
+ *            built from the current JSON files, otherwise parses the
+ *            JSON files.
+ *   @param   read_file Reads the game data files.
+ *   @return  True if the world was loaded.
+ */
+bool WorldData::load(const DATA::FileReader& read_file)
+{
+  DATA::FileBuffer image;
+  if (read_file(IMAGE::FILE_NAME, &image) &&
+      imageIsCurrent(image, read_file) &&
+      loadImage(image.data(), image.size()))
+  {
+    return true;
+  }
+  return loadSource(read_file);
+}
+
+/**
+ *   @brief   Loads the world from the JSON files
+ *   @param   read_file Reads the game data files.
+ *   @return  True if every file was loaded.
+ */
+bool WorldData::loadSource(const DATA::FileReader& read_file)
+{
+  rooms.clear();
+  objects.clear();
+  actions.clear();
+  treasures.clear();
+
+  bool rooms_loaded = loadRooms(read_file);
+  bool objects_loaded = loadObjects(read_file);
+  bool actions_loaded = loadActions(read_file);
+
+  compile();
+  return rooms_loaded && objects_loaded && actions_loaded;
+}
+
+/**
+ *   @brief   Loads the world from a compiled world image
+ *   @details The tables are read in place, no parsing is done. The
+ *            image is rejected if it is from another version, is
+ *            damaged or its tables don't fit in it.
+ *   @param   image The image bytes, e.g. a mapped world.bin.
+ *   @param   size The size of the image in bytes.
+ *   @return  True if the image was valid and loaded.
+ */
+bool WorldData::loadImage(const char* image, size_t size)
+{
+  IMAGE::Header header = {};
+  if (size < sizeof(header))
+  {
+    return false;
+  }
+  std::memcpy(&header, image, sizeof(header));
+
+  if (header.magic != IMAGE::MAGIC || header.version != IMAGE::VERSION ||
+      header.size != size ||
+      !validTable<IMAGE::RoomRecord>(
+        header.rooms_offset, header.room_count, size) ||
+      !validTable<IMAGE::ObjectRecord>(
+        header.objects_offset, header.object_count, size) ||
+      !validTable<IMAGE::ActionRecord>(
+        header.actions_offset, header.action_count, size) ||
+      header.strings_offset + static_cast<size_t>(header.strings_size) >
+        size ||
+      reinterpret_cast<uintptr_t>(image) % alignof(IMAGE::Header) != 0)
+  {
+    std::cout << "World image is not valid" << std::endl;
+    return false;
+  }
+
+  if (header.checksum != IMAGE::checksum(image + sizeof(header),
+                                         size - sizeof(header)))
+  {
+    std::cout << "World image is damaged" << std::endl;
+    return false;
+  }
+
+  rooms.assign(header.room_count, Room());
+  objects.assign(header.object_count, Object());
+  actions.assign(header.action_count, Action());
+  treasures.clear();
+
+  auto room_records =
+    imageTable<IMAGE::RoomRecord>(image, header.rooms_offset);
+  for (size_t i = 0; i < rooms.size(); i++)
+  {
+    const IMAGE::RoomRecord& record = room_records[i];
+    std::string name = imageString(header, image, record.name);
+    int items[DATA::ROOM_ITEM_NUM];
+    for (int j = 0; j < DATA::ROOM_ITEM_NUM; j++)
+    {
+      items[j] = record.items[j];
+    }
+    int room_links[DATA::DIRECTION_NUM];
+    for (int j = 0; j < DATA::DIRECTION_NUM; j++)
+    {
+      room_links[j] = record.links[j];
+    }
+
+    rooms[i].setup(record.id,
+                   &name,
+                   record.exits,
+                   room_links,
+                   items,
+                   record.dark != 0,
+                   record.teleport != 0);
+  }
+
+  auto object_records =
+    imageTable<IMAGE::ObjectRecord>(image, header.objects_offset);
+  for (size_t i = 0; i < objects.size(); i++)
+  {
+    const IMAGE::ObjectRecord& record = object_records[i];
+    std::string name = imageString(header, image, record.name);
+    std::string description = imageString(header, image, record.description);
+
+    if (record.treasure != 0)
+    {
+      treasures.push_back(static_cast<int>(i));
+    }
+
+    objects[i].setup(record.id,
+                     &name,
+                     &description,
+                     record.collectible != 0,
+                     record.hidden != 0,
+                     record.treasure != 0);
+  }
+
+  auto action_records =
+    imageTable<IMAGE::ActionRecord>(image, header.actions_offset);
+  for (size_t i = 0; i < actions.size(); i++)
+  {
+    const IMAGE::ActionRecord& record = action_records[i];
+    int required_objects[3] = { record.required_objects[0],
+                                record.required_objects[1],
+                                record.required_objects[2] };
+
+    actions[i].setup(record.id,
+                     imageString(header, image, record.verb),
+                     record.object,
+                     required_objects,
+                     record.required_room,
+                     imageString(header, image, record.response));
+  }
+
+  compile();
+  std::cout << "Loaded World Image" << std::endl;
+  return true;
+}
+
+/**
+ *   @brief   Reloads one of the JSON files
+ *   @details Only the named file is parsed again, the rest of the world
+ *            is kept. Call on a copy of the world, as the world is left
+ *            part loaded if the file is damaged.
+ *   @param   read_file Reads the game data files.
+ *   @param   file_name The file that changed, e.g. "rooms.json".
+ *   @return  True if the file loaded and the world is still playable.
+ */
+bool WorldData::reload(const DATA::FileReader& read_file,
+                       const std::string& file_name)
+{
+  bool loaded = false;
+  if (file_name == "rooms.json")
+  {
+    loaded = loadRooms(read_file);
+  }
+  else if (file_name == "objects.json")
+  {
+    loaded = loadObjects(read_file);
+  }
+  else if (file_name == "actions.json")
+  {
+    loaded = loadActions(read_file);
+  }
+
+  if (!loaded)
+  {
+    return false;
+  }
+  compile();
+  return playable();
+}
+
+/**
+ *   @brief   Whether the game's rules can be played in the world
+ *   @details The rules refer to some rooms, objects and actions by ID,
+ *            so those must all be there, and every record must be at
+ *            the index its ID says.
+ */
+bool WorldData::playable() const
+{
+  if (roomCount() < DATA::RULE_ROOM_NUM ||
+      objectCount() < DATA::RULE_OBJECT_NUM ||
+      actionCount() < DATA::RULE_ACTION_NUM)
+  {
+    return false;
+  }
+
+  for (int i = 0; i < roomCount(); i++)
+  {
+    if (rooms[i].roomID() != i)
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < objectCount(); i++)
+  {
+    if (objects[i].objectID() != i + 1)
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < actionCount(); i++)
+  {
+    if (actions[i].actionID() != i)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ *   @brief   Carries a game over from another version of the world
+ *   @details Rooms and objects are matched by ID. Matched rooms keep
+ *            their exits and matched objects keep where they are, in
+ *            the same order, and whether they are hidden. Anything new
+ *            starts as it would in a new game. The player's own values
+ *            are kept, moving them to the start if their room is gone.
+ *   @param   state A game in the old world.
+ *   @param   old_world The world the game was played in.
+ *   @return  The game in this world.
+ */
+SessionState WorldData::migrate(const SessionState& state,
+                                const WorldData& old_world) const
+{
+  SessionState migrated = starting_state;
+  const int room_count = std::min(roomCount(), old_world.roomCount());
+  const int object_count = std::min(objectCount(), old_world.objectCount());
+
+  for (int i = 0; i < room_count; i++)
+  {
+    migrated.exits[i] = state.exits[i];
+  }
+  for (int i = 0; i < object_count; i++)
+  {
+    migrated.hidden_objects[i] = state.hidden_objects[i];
+  }
+
+  // rebuild the room lists, kept objects first in their old order, an
+  // object left out of every list, e.g. carried, has no links
+  std::vector<int32_t> start_location = migrated.object_location;
+  migrated.object_location.assign(objects.size(), DATA::NOWHERE);
+  migrated.object_next.assign(objects.size(), -1);
+  migrated.object_prev.assign(objects.size(), -1);
+  migrated.room_first.assign(rooms.size(), -1);
+  migrated.room_last.assign(rooms.size(), -1);
+  for (int room = 0; room < room_count; room++)
+  {
+    for (int32_t i = state.room_first[room]; i != -1; i = state.object_next[i])
+    {
+      if (i < object_count)
+      {
+        linkLast(&migrated, i, room);
+      }
+    }
+  }
+  for (int i = 0; i < objectCount(); i++)
+  {
+    const bool kept = i < object_count && state.object_location[i] < room_count;
+    if (!kept && start_location[i] >= 0)
+    {
+      linkLast(&migrated, i, start_location[i]);
+    }
+  }
+
+  for (int i = 0; i < state.inventory.count; i++)
+  {
+    int32_t object = state.inventory.objects[i];
+    if (object < object_count)
+    {
+      migrated.object_location[object] = DATA::CARRIED;
+      migrated.inventory.add(object, objects[object].treasure());
+    }
+  }
+
+  migrated.current_room =
+    state.current_room < roomCount() ? state.current_room
+                                     : starting_state.current_room;
+  migrated.light_amount = state.light_amount;
+  migrated.score = state.score;
+  migrated.light_ignited = state.light_ignited;
+  migrated.axed_tree = state.axed_tree;
+  migrated.up_tree = state.up_tree;
+  migrated.in_end_state = state.in_end_state;
+  migrated.game_over = state.game_over;
+  migrated.revision = state.revision;
+  migrated.random_engine = state.random_engine;
+  return migrated;
+}
+
+int WorldData::roomCount() const
+{
+  return static_cast<int>(rooms.size());
+}
+
+int WorldData::objectCount() const
+{
+  return static_cast<int>(objects.size());
+}
+
+int WorldData::actionCount() const
+{
+  return static_cast<int>(actions.size());
+}
+
+/**
+ *   @brief   The number of treasures to collect to win
+ */
+int WorldData::treasureCount() const
+{
+  return static_cast<int>(treasures.size());
+}
+
+/**
+ *   @brief   The number of rooms the SAY spell can send the player to
+ */
+int WorldData::teleportCount() const
+{
+  return static_cast<int>(teleport_rooms.size());
+}
+
+const Room& WorldData::room(int i) const
+{
+  return rooms[i];
+}
+
+const Object& WorldData::object(int i) const
+{
+  return objects[i];
+}
+
+const Action& WorldData::action(int i) const
+{
+  return actions[i];
+}
+
+int WorldData::treasure(int i) const
+{
+  return treasures[i];
+}
+
+/**
+ *   @brief   A room the SAY spell can send the player to
+ *   @param   i From 0 to teleportCount(), rooms are in ID order.
+ */
+int WorldData::teleportRoom(int i) const
+{
+  return teleport_rooms[i];
+}
+
+/**
+ *   @brief   The state of a session at the start of the game
+ *   @details Copy this into a session to start a new game.
+ */
+const SessionState& WorldData::startingState() const
+{
+  return starting_state;
+}
+
+/**
+ *   @brief   The compiled preconditions of an action
+ */
+const Precondition& WorldData::precondition(int action) const
+{
+  return preconditions[action];
+}
+
+/**
+ *   @brief   Builds everything derived from the loaded definitions
+ */
+void WorldData::compile()
+{
+  buildStartingState();
+  buildLexicons();
+  buildPreconditions();
+  buildLinks();
+}
+
+/**
+ *   @brief   The room an exit leads to
+ *   @param   room The room's index.
+ *   @param   direction See DATA::NORTH etc.
+ *   @return  The room's index, or -1 if there's no exit that way.
+ */
+int WorldData::link(int room, int direction) const
+{
+  return link_table[static_cast<size_t>(room) * DATA::DIRECTION_NUM +
+                    static_cast<size_t>(direction)];
+}
+
+/**
+ *   @brief   The direction an action moves the player in
+ *   @return  See DATA::NORTH etc, or -1 if the action isn't a move.
+ */
+int WorldData::actionDirection(int action) const
+{
+  return action_directions[action];
+}
+
+void WorldData::buildLinks()
+{
+  const int room_count = roomCount();
+  link_table.resize(rooms.size() * DATA::DIRECTION_NUM);
+  teleport_rooms.clear();
+  for (int i = 0; i < room_count; i++)
+  {
+    for (int j = 0; j < DATA::DIRECTION_NUM; j++)
+    {
+      int link = rooms[i].link(j);
+      link_table[static_cast<size_t>(i) * DATA::DIRECTION_NUM + j] =
+        link >= 0 && link < room_count ? link : -1;
+    }
+
+    if (rooms[i].teleportTarget())
+    {
+      teleport_rooms.push_back(i);
+    }
+  }
+
+  action_directions.resize(actions.size());
+  for (int i = 0; i < actionCount(); i++)
+  {
+    action_directions[i] = -1;
+    for (int j = 0; j < DATA::DIRECTION_NUM; j++)
+    {
+      if (actions[i].actionVerb() == DIRECTION_VERBS[j])
+      {
+        action_directions[i] = j;
+      }
+    }
+  }
+}
+
+void WorldData::buildPreconditions()
+{
+  preconditions.assign(actions.size(), Precondition());
+  for (int i = 0; i < actionCount(); i++)
+  {
+    Precondition& rule = preconditions[i];
+
+    // the objects are only required when the first slot is used
+    const int* needed = actions[i].objectsNeeded();
+    for (int j = 0; j < 3 && needed[0] != -1; j++)
+    {
+      int object = needed[j] - 1;
+      rule.carried[j] = object >= 0 && object < objectCount() ? object : -1;
+    }
+
+    rule.room = actions[i].requiredRoom();
+    rule.object = actions[i].actionObject();
+
+    if (i + 1 < actionCount() &&
+        actions[i + 1].actionVerb() == actions[i].actionVerb())
+    {
+      rule.alternative = i + 1;
+    }
+  }
+}
+
+/**
+ *   @brief   The words that name each action, mapped to action IDs
+ *   @details Where actions share a verb the first action is used.
+ */
+const Lexicon& WorldData::verbs() const
+{
+  return verb_lexicon;
+}
+
+/**
+ *   @brief   The words that name each object, mapped to object indexes
+ */
+const Lexicon& WorldData::nouns() const
+{
+  return noun_lexicon;
+}
+
+void WorldData::buildLexicons()
+{
+  verb_lexicon.clear();
+  for (int i = 0; i < actionCount(); i++)
+  {
+    verb_lexicon.add(actions[i].actionVerb(), actions[i].actionID());
+  }
+  verb_lexicon.compile();
+
+  for (const auto& synonym : VERB_SYNONYMS)
+  {
+    std::string verb = synonym[1];
+    int id = verb_lexicon.find(verb.data(), verb.size());
+    if (id != -1)
+    {
+      verb_lexicon.add(synonym[0], id);
+    }
+  }
+  verb_lexicon.compile();
+
+  noun_lexicon.clear();
+  for (int i = 0; i < objectCount(); i++)
+  {
+    noun_lexicon.add(objects[i].objectName(), objects[i].objectID() - 1);
+  }
+  noun_lexicon.compile();
+}
+
+void WorldData::buildStartingState()
+{
+  SessionState& state = starting_state;
+  const int room_count = roomCount();
+  const int object_count = objectCount();
+
+  state.object_location.assign(objects.size(), DATA::NOWHERE);
+  state.object_next.assign(objects.size(), -1);
+  state.object_prev.assign(objects.size(), -1);
+  state.exits.resize(rooms.size());
+  state.room_first.assign(rooms.size(), -1);
+  state.room_last.assign(rooms.size(), -1);
+
+  for (int i = 0; i < room_count; i++)
+  {
+    state.exits[i] = static_cast<uint16_t>(rooms[i].startingExits());
+
+    // link the room's objects in the order they're listed
+    for (int j = 0; j < DATA::ROOM_ITEM_NUM; j++)
+    {
+      int object = rooms[i].startingObjects()[j] - 1;
+      if (object < 0 || object >= object_count ||
+          state.object_location[object] != DATA::NOWHERE)
+      {
+        continue;
+      }
+
+      linkLast(&state, object, i);
+    }
+  }
+
+  state.hidden_objects.assign(objects.size(), 0);
+  for (int i = 0; i < object_count; i++)
+  {
+    state.hidden_objects[i] = objects[i].startsHidden() ? 1 : 0;
+  }
+  state.inventory.clear(object_count);
+
+  state.current_room = DATA::START_ROOM < room_count ? DATA::START_ROOM : 0;
+  state.light_amount = DATA::START_LIGHT;
+  state.score = 0;
+
+  state.light_ignited = false;
+  state.axed_tree = false;
+  state.up_tree = false;
+  state.in_end_state = false;
+  state.game_over = false;
+
+  state.revision = 0;
+}
+
+bool WorldData::loadRooms(const DATA::FileReader& read_file)
+{
+  PROFILER::Zone zone("loadRooms");
+  DATA::FileBuffer buffer;
+
+  // Read file
+  if (!read_file("rooms.json", &buffer))
+  {
+    std::cout << "Rooms file not found" << std::endl;
+    return false;
+  }
+
+  enum Field
+  {
+    ID,
+    NAME,
+    EXITS,
+    LINKS,
+    ITEMS,
+    DARK,
+    TELEPORT
+  };
+  RecordReader reader(
+    { "ID", "Name", "Exits", "Links", "Items", "Dark", "Teleport" });
+  rooms.clear();
+
+  // rooms without links are laid out on the original 8 wide grid, which
+  // needs the number of rooms, so they're linked once every room is read
+  std::vector<int> grid_rooms;
+  std::vector<int> lines;
+
+  // Populate each room with it's information as it's read
+  bool read = reader.read(buffer.data(), buffer.size(), [&] {
+    int id = reader.integer(ID);
+    const std::string& name = reader.text(NAME);
+
+    // one flag per direction, from NORTH, missing directions are closed
+    int exits = 0;
+    const int exit_count =
+      std::min(reader.listSize(EXITS), DATA::DIRECTION_NUM);
+    for (int i = 0; i < exit_count; i++)
+    {
+      exits |= reader.listFlag(EXITS, i) ? 1 << i : 0;
+    }
+
+    // the room ID each exit leads to
+    int room_links[DATA::DIRECTION_NUM];
+    std::fill(room_links, room_links + DATA::DIRECTION_NUM, -1);
+    if (reader.has(LINKS))
+    {
+      const int link_count =
+        std::min(reader.listSize(LINKS), DATA::DIRECTION_NUM);
+      for (int i = 0; i < link_count; i++)
+      {
+        room_links[i] = reader.listInteger(LINKS, i);
+      }
+    }
+    else
+    {
+      grid_rooms.push_back(id);
+    }
+
+    int items[DATA::ROOM_ITEM_NUM] = {};
+    if (reader.listSize(ITEMS) < DATA::ROOM_ITEM_NUM)
+    {
+      reader.reject(ITEMS, "a list of 5 object IDs");
+      return;
+    }
+    for (int i = 0; i < DATA::ROOM_ITEM_NUM; i++)
+    {
+      items[i] = reader.listInteger(ITEMS, i);
+    }
+    bool dark = reader.flag(DARK);
+    bool teleport = reader.has(TELEPORT) && reader.flag(TELEPORT);
+
+    rooms.emplace_back();
+    rooms.back().setup(id, &name, exits, room_links, items, dark, teleport);
+    lines.push_back(reader.recordLine());
+  });
+
+  if (!read)
+  {
+    std::cout << "rooms.json " << reader.error() << std::endl;
+    return false;
+  }
+
+  auto room_id = [](const Room& room) { return room.roomID(); };
+  if (!placeRecords(&rooms, lines, 0, "rooms.json", "Room", room_id))
+  {
+    return false;
+  }
+  const int room_count = roomCount();
+  for (int id : grid_rooms)
+  {
+    if (id < 0 || id >= room_count)
+    {
+      continue;
+    }
+    Room& room = rooms[id];
+    int room_links[DATA::DIRECTION_NUM];
+    int items[DATA::ROOM_ITEM_NUM];
+    for (int i = 0; i < DATA::DIRECTION_NUM; i++)
+    {
+      room_links[i] = gridLink(id, i, room_count);
+    }
+    std::copy(room.startingObjects(),
+              room.startingObjects() + DATA::ROOM_ITEM_NUM,
+              items);
+    std::string name = room.roomName();
+    room.setup(id,
+               &name,
+               room.startingExits(),
+               room_links,
+               items,
+               room.needsLight(),
+               room.teleportTarget());
+  }
+
+  std::cout << "Loaded Rooms" << std::endl;
+  return true;
+}
+
+bool WorldData::loadObjects(const DATA::FileReader& read_file)
+{
+  PROFILER::Zone zone("loadObjects");
+  DATA::FileBuffer buffer;
+
+  // Read file
+  if (!read_file("objects.json", &buffer))
+  {
+    std::cout << "Objects file not found" << std::endl;
+    return false;
+  }
+
+  enum Field
+  {
+    ID,
+    NAME,
+    DESCRIPTION,
+    COLLECTIBLE,
+    HIDDEN,
+    TREASURE
+  };
+  RecordReader reader(
+    { "ID", "Name", "Description", "Collectible", "Hidden", "Treasure" });
+  objects.clear();
+  treasures.clear();
+  std::vector<int> lines;
+
+  // Populate each object with it's information as it's read
+  bool read = reader.read(buffer.data(), buffer.size(), [&] {
+    int id = reader.integer(ID);
+    const std::string& name = reader.text(NAME);
+    const std::string& description = reader.text(DESCRIPTION);
+    bool carry = reader.flag(COLLECTIBLE);
+    bool hide = reader.flag(HIDDEN);
+    bool treasure = reader.flag(TREASURE);
+
+    objects.emplace_back();
+    objects.back().setup(id, &name, &description, carry, hide, treasure);
+    lines.push_back(reader.recordLine());
+  });
+
+  if (!read)
+  {
+    std::cout << "objects.json " << reader.error() << std::endl;
+    return false;
+  }
+
+  auto object_id = [](const Object& object) { return object.objectID(); };
+  if (!placeRecords(&objects, lines, 1, "objects.json", "Object", object_id))
+  {
+    return false;
+  }
+  for (int i = 0; i < objectCount(); i++)
+  {
+    if (objects[i].treasure())
+    {
+      treasures.push_back(i);
+    }
+  }
+
+  std::cout << "Loaded Objects" << std::endl;
+  return true;
+}
+
+bool WorldData::loadActions(const DATA::FileReader& read_file)
+{
+  PROFILER::Zone zone("loadActions");
+  DATA::FileBuffer buffer;
+
+  // Read file
+  if (!read_file("actions.json", &buffer))
+  {
+    std::cout << "Actions file not found" << std::endl;
+    return false;
+  }
+
+  enum Field
+  {
+    ID,
+    VERB,
+    OBJECT,
+    REQUIRED_OBJECTS,
+    REQUIRED_ROOM,
+    RESPONSE
+  };
+  RecordReader reader({ "ID",
+                        "Verb",
+                        "Object",
+                        "Required Objects",
+                        "Required Room",
+                        "Response" });
+  actions.clear();
+  std::vector<int> lines;
+
+  // Populate each action with it's information as it's read
+  bool read = reader.read(buffer.data(), buffer.size(), [&] {
+    int id = reader.integer(ID);
+    const std::string& verb = reader.text(VERB);
+    int second_word = reader.integer(OBJECT);
+
+    int required_objects[3] = {};
+    if (reader.listSize(REQUIRED_OBJECTS) < 3)
+    {
+      reader.reject(REQUIRED_OBJECTS, "a list of 3 object IDs");
+      return;
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      required_objects[i] = reader.listInteger(REQUIRED_OBJECTS, i);
+    }
+    int required_room = reader.integer(REQUIRED_ROOM);
+    const std::string& response = reader.text(RESPONSE);
+
+    actions.emplace_back();
+    actions.back().setup(
+      id, verb, second_word, required_objects, required_room, response);
+    lines.push_back(reader.recordLine());
+  });
+
+  if (!read)
+  {
+    std::cout << "actions.json " << reader.error() << std::endl;
+    return false;
+  }
+
+  auto action_id = [](const Action& action) { return action.actionID(); };
+  if (!placeRecords(&actions, lines, 0, "actions.json", "Action", action_id))
+  {
+    return false;
+  }
+
+  std::cout << "Loaded Actions" << std::endl;
+  return true;
+}
@@ -0,0 +1,97 @@
+//
+// Created by Zoe on 06/11/2019.
+//
+
+#ifndef PROJECT_WORLDDATA_H
+#define PROJECT_WORLDDATA_H
+
+#include "../Action.h"
+#include "../game/GameConstants.h"
+#include "../session/DataReader.h"
+#include "../session/SessionState.h"
+#include "Lexicon.h"
+#include "Object.h"
+#include "Room.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ *  What must be true for an action to be performed.
+ *  Compiled from the action definitions when the world loads.
+ */
+struct Precondition
+{
+  /** Indexes of the objects that must be carried, -1 for none. */
+  int carried[3] = { -1, -1, -1 };
+  int room = -1;        /**< Room the action must be done in, or -1. */
+  int object = -1;      /**< Object ID acted on, 0 for any, -1 for none. */
+  int alternative = -1; /**< Next action with the same verb, or -1. */
+};
+
+/**
+ *  The read-only definition of the world.
+ *  Loaded once, from the compiled world image if there is one or from
+ *  the JSON files otherwise, and shared by every session playing it.
+ *  Also keeps a snapshot of the state at the start of the game, so a
+ *  new game is a single copy with no file access or parsing. The
+ *  number of rooms, objects and actions comes from the data.
+ */
+class WorldData
+{
+ public:
+  WorldData() = default;
+  ~WorldData() = default;
+
+  bool load(const DATA::FileReader& read_file);
+  bool loadSource(const DATA::FileReader& read_file);
+  bool loadImage(const char* image, size_t size);
+  bool reload(const DATA::FileReader& read_file, const std::string& file_name);
+  bool playable() const;
+  SessionState migrate(const SessionState& state,
+                       const WorldData& old_world) const;
+
+  int roomCount() const;
+  int objectCount() const;
+  int actionCount() const;
+  int treasureCount() const;
+  int teleportCount() const;
+
+  const Room& room(int i) const;
+  const Object& object(int i) const;
+  const Action& action(int i) const;
+  int treasure(int i) const;
+  int teleportRoom(int i) const;
+  const SessionState& startingState() const;
+  const Lexicon& verbs() const;
+  const Lexicon& nouns() const;
+  const Precondition& precondition(int action) const;
+  int link(int room, int direction) const;
+  int actionDirection(int action) const;
+
+ private:
+  bool loadRooms(const DATA::FileReader& read_file);
+  bool loadObjects(const DATA::FileReader& read_file);
+  bool loadActions(const DATA::FileReader& read_file);
+  void compile();
+  void buildStartingState();
+  void buildLexicons();
+  void buildPreconditions();
+  void buildLinks();
+
+  std::vector<Room> rooms;
+  std::vector<Object> objects;
+  std::vector<Action> actions;
+  std::vector<Precondition> preconditions;
+  std::vector<int32_t> link_table; /**< DIRECTION_NUM links per room. */
+  std::vector<int> action_directions;
+  std::vector<int> treasures;
+  std::vector<int> teleport_rooms; /**< Rooms SAY can send the player to. */
+
+  SessionState starting_state = SessionState();
+  Lexicon verb_lexicon;
+  Lexicon noun_lexicon;
+};
+
+#endif // PROJECT_WORLDDATA_H
@@ -0,0 +1,182 @@
+//
+// Created by Zoe on 08/11/2019.
+//
+
+#include "WorldImage.h"
+#include "WorldData.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+IMAGE::StringRef addString(std::string* strings, const std::string& value)
+{
+  IMAGE::StringRef ref = { static_cast<uint32_t>(strings->size()),
+                           static_cast<uint32_t>(value.size()) };
+  strings->append(value);
+  return ref;
+}
+
+template<typename Record>
+void addRecord(std::vector<char>* image, const Record& record)
+{
+  const char* bytes = reinterpret_cast<const char*>(&record);
+  image->insert(image->end(), bytes, bytes + sizeof(Record));
+}
+
+// the files an image is built from, in the order they are hashed
+const char* const SOURCE_FILES[] = { "rooms.json",
+                                     "objects.json",
+                                     "actions.json" };
+
+const uint32_t FNV_OFFSET = 2166136261u;
+
+uint32_t fnv(uint32_t hash, const char* bytes, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    hash ^= static_cast<uint8_t>(bytes[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+uint32_t alignedSize(size_t size)
+{
+  return static_cast<uint32_t>((size + 3) & ~static_cast<size_t>(3));
+}
+}
+
+/**
+ *   @brief   FNV-1a hash of the image contents
+ */
+uint32_t IMAGE::checksum(const char* bytes, size_t length)
+{
+  return fnv(FNV_OFFSET, bytes, length);
+}
+
+/**
+ *   @brief   FNV-1a hash of the JSON files a world is built from
+ *   @details Any edit to rooms.json, objects.json or actions.json
+ *            changes it.
+ *   @param   read_file Reads the game data files.
+ *   @param   hash Set to the hash.
+ *   @return  False if any of the files couldn't be read.
+ */
+bool IMAGE::sourceHash(const DATA::FileReader& read_file, uint32_t* hash)
+{
+  uint32_t value = FNV_OFFSET;
+  for (const char* file_name : SOURCE_FILES)
+  {
+    DATA::FileBuffer buffer;
+    if (!read_file(file_name, &buffer))
+    {
+      return false;
+    }
+    value = fnv(value, buffer.data(), buffer.size());
+  }
+  *hash = value;
+  return true;
+}
+
+/**
+ *   @brief   Compiles loaded world data into an image
+ *   @param   world_data The world to compile.
+ *   @param   source_hash sourceHash() of the files it was loaded from.
+ *   @return  The image bytes, ready for WorldData::loadImage().
+ */
+std::vector<char> IMAGE::build(const WorldData& world_data,
+                               uint32_t source_hash)
+{
+  std::string strings;
+  std::vector<char> image(sizeof(Header));
+
+  Header header = {};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.source_hash = source_hash;
+
+  header.room_count = static_cast<uint32_t>(world_data.roomCount());
+  header.rooms_offset = static_cast<uint32_t>(image.size());
+  for (int i = 0; i < world_data.roomCount(); i++)
+  {
+    const Room& room = world_data.room(i);
+    RoomRecord record = {};
+    record.id = room.roomID();
+    record.name = addString(&strings, room.roomName());
+    for (int j = 0; j < DATA::ROOM_ITEM_NUM; j++)
+    {
+      record.items[j] = room.startingObjects()[j];
+    }
+    record.exits = static_cast<uint16_t>(room.startingExits());
+    record.dark = room.needsLight() ? 1 : 0;
+    record.teleport = room.teleportTarget() ? 1 : 0;
+    for (int j = 0; j < DATA::DIRECTION_NUM; j++)
+    {
+      record.links[j] = room.link(j);
+    }
+    addRecord(&image, record);
+  }
+
+  header.object_count = static_cast<uint32_t>(world_data.objectCount());
+  header.objects_offset = static_cast<uint32_t>(image.size());
+  for (int i = 0; i < world_data.objectCount(); i++)
+  {
+    const Object& object = world_data.object(i);
+    ObjectRecord record = {};
+    record.id = object.objectID();
+    record.name = addString(&strings, object.objectName());
+    record.description = addString(&strings, object.examine());
+    record.collectible = object.collectible() ? 1 : 0;
+    record.hidden = object.startsHidden() ? 1 : 0;
+    record.treasure = object.treasure() ? 1 : 0;
+    addRecord(&image, record);
+  }
+
+  header.action_count = static_cast<uint32_t>(world_data.actionCount());
+  header.actions_offset = static_cast<uint32_t>(image.size());
+  for (int i = 0; i < world_data.actionCount(); i++)
+  {
+    const Action& action = world_data.action(i);
+    ActionRecord record = {};
+    record.id = action.actionID();
+    record.verb = addString(&strings, action.actionVerb());
+    record.object = action.actionObject();
+    for (int j = 0; j < 3; j++)
+    {
+      record.required_objects[j] = action.objectsNeeded()[j];
+    }
+    record.required_room = action.requiredRoom();
+    record.response = addString(&strings, action.output());
+    addRecord(&image, record);
+  }
+
+  header.strings_offset = static_cast<uint32_t>(image.size());
+  header.strings_size = static_cast<uint32_t>(strings.size());
+  image.insert(image.end(), strings.begin(), strings.end());
+  image.resize(alignedSize(image.size()));
+
+  header.size = static_cast<uint32_t>(image.size());
+  header.checksum =
+    checksum(image.data() + sizeof(Header), image.size() - sizeof(Header));
+  std::memcpy(image.data(), &header, sizeof(Header));
+  return image;
+}
+
+/**
+ *   @brief   Compiles loaded world data into an image file
+ *   @param   world_data The world to compile.
+ *   @param   source_hash sourceHash() of the files it was loaded from.
+ *   @param   path Where to write the image.
+ *   @return  False if the file could not be written.
+ */
+bool IMAGE::write(const WorldData& world_data,
+                  uint32_t source_hash,
+                  const std::string& path)
+{
+  std::vector<char> image = build(world_data, source_hash);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(image.data(), static_cast<std::streamsize>(image.size()));
+  return static_cast<bool>(file);
+}
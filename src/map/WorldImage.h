@@ -0,0 +1,101 @@
+//
+// Created by Zoe on 08/11/2019.
+//
+
+#ifndef PROJECT_WORLDIMAGE_H
+#define PROJECT_WORLDIMAGE_H
+
+#include "session/DataReader.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class WorldData;
+
+/**
+ *  The compiled world image.
+ *  A little-endian file made of a header, fixed-layout room, object
+ *  and action tables and a single blob holding every string. Strings
+ *  are stored as an offset and length into the blob. The checksum
+ *  covers everything after the header, and the source hash is the
+ *  hash of the JSON files it was built from, so an image left over
+ *  from older JSON can be told apart.
+ */
+namespace IMAGE
+{
+const uint32_t MAGIC = 0x44574248; /**< "HBWD" */
+const uint32_t VERSION = 4;
+const char* const FILE_NAME = "world.bin";
+
+struct StringRef
+{
+  uint32_t offset;
+  uint32_t length;
+};
+
+struct Header
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t checksum;
+  uint32_t source_hash; /**< sourceHash() of the JSON files. */
+  uint32_t size;        /**< Size of the whole image in bytes. */
+
+  uint32_t room_count;
+  uint32_t object_count;
+  uint32_t action_count;
+
+  uint32_t rooms_offset;
+  uint32_t objects_offset;
+  uint32_t actions_offset;
+  uint32_t strings_offset;
+  uint32_t strings_size;
+};
+
+struct RoomRecord
+{
+  int32_t id;
+  StringRef name;
+  int32_t items[5];
+  uint16_t exits; /**< Bit per direction. */
+  uint8_t dark;
+  uint8_t teleport;
+  int32_t links[10]; /**< Room ID per direction, or -1. */
+};
+
+struct ObjectRecord
+{
+  int32_t id;
+  StringRef name;
+  StringRef description;
+  uint8_t collectible;
+  uint8_t hidden;
+  uint8_t treasure;
+  uint8_t padding;
+};
+
+struct ActionRecord
+{
+  int32_t id;
+  StringRef verb;
+  int32_t object;
+  int32_t required_objects[3];
+  int32_t required_room;
+  StringRef response;
+};
+
+static_assert(sizeof(Header) == 52, "image header layout changed");
+static_assert(sizeof(RoomRecord) == 76, "image room layout changed");
+static_assert(sizeof(ObjectRecord) == 24, "image object layout changed");
+static_assert(sizeof(ActionRecord) == 40, "image action layout changed");
+
+uint32_t checksum(const char* bytes, size_t length);
+bool sourceHash(const DATA::FileReader& read_file, uint32_t* hash);
+std::vector<char> build(const WorldData& world_data, uint32_t source_hash);
+bool write(const WorldData& world_data,
+           uint32_t source_hash,
+           const std::string& path);
+};
+
+#endif // PROJECT_WORLDIMAGE_H
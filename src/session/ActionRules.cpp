@@ -0,0 +1,58 @@
+//
+// Created by Zoe on 11/11/2019.
+//
+
+#include "ActionRules.h"
+
+/**
+ *   @brief   Checks an action's preconditions
+ *   @details Where two actions share a verb, e.g. OPEN, the second is
+ *            used when the object given is the one it acts on.
+ *   @param   world_data The world the action is defined in.
+ *   @param   state The session performing the action.
+ *   @param   action The action's ID, changed if its alternative is used.
+ *   @param   object The object's index, or -1 if no object was given.
+ *   @return  VALID, or the first precondition that failed.
+ */
+RULES::Result RULES::check(const WorldData& world_data,
+                           const SessionState& state,
+                           int* action,
+                           int object)
+{
+  const Precondition* rule = &world_data.precondition(*action);
+
+  if (rule->object != -1 && object == -1)
+  {
+    return NEEDS_OBJECT;
+  }
+
+  if (rule->alternative != -1)
+  {
+    const Precondition& alternative =
+      world_data.precondition(rule->alternative);
+    if (object + 1 == alternative.object)
+    {
+      *action = rule->alternative;
+      rule = &alternative;
+    }
+  }
+  else if (rule->object > 0 && object + 1 != rule->object)
+  {
+    return WRONG_OBJECT;
+  }
+
+  for (int required : rule->carried)
+  {
+    if (required != -1 && !state.inventory.has(required))
+    {
+      return MISSING_OBJECTS;
+    }
+  }
+
+  if (rule->room != -1 && rule->room != state.current_room)
+  {
+    return WRONG_ROOM;
+  }
+
+  return VALID;
+}
@@ -0,0 +1,34 @@
+//
+// Created by Zoe on 11/11/2019.
+//
+
+#ifndef PROJECT_ACTIONRULES_H
+#define PROJECT_ACTIONRULES_H
+
+#include "../map/WorldData.h"
+#include "SessionState.h"
+
+/**
+ *  Checks whether an action can be performed.
+ *  Each action's preconditions are compiled by WorldData when it loads,
+ *  so a check is a handful of compares and a mask against the objects
+ *  the session is carrying.
+ */
+namespace RULES
+{
+enum Result
+{
+  VALID,
+  NEEDS_OBJECT,    /**< The action needs a noun and none was given. */
+  WRONG_OBJECT,    /**< The action can't be done to that object. */
+  MISSING_OBJECTS, /**< The player isn't carrying what's required. */
+  WRONG_ROOM       /**< The action can't be done in this room. */
+};
+
+Result check(const WorldData& world_data,
+             const SessionState& state,
+             int* action,
+             int object);
+}
+
+#endif // PROJECT_ACTIONRULES_H
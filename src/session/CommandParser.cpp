@@ -0,0 +1,62 @@
+//
+// Created by Zoe on 10/11/2019.
+//
+
+#include "CommandParser.h"
+#include <cctype>
+
+namespace
+{
+bool isSpace(char c)
+{
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/**
+ *   @brief   Finds the next word in the line
+ *   @param   position Where to start looking, moved past the word.
+ *   @param   end The end of the line.
+ *   @param   length Set to the length of the word, 0 if there isn't one.
+ *   @return  The start of the word.
+ */
+const char* nextWord(const char** position, const char* end, size_t* length)
+{
+  const char* word = *position;
+  while (word != end && isSpace(*word))
+  {
+    ++word;
+  }
+
+  const char* word_end = word;
+  while (word_end != end && !isSpace(*word_end))
+  {
+    ++word_end;
+  }
+
+  *position = word_end;
+  *length = static_cast<size_t>(word_end - word);
+  return word;
+}
+}
+
+/**
+ *   @brief   Parses a command
+ *   @param   world_data The world whose words are used.
+ *   @param   line The line typed by the player, e.g. "GET ROPE".
+ *   @return  The action and object the line names.
+ */
+COMMAND::Parsed
+COMMAND::parse(const WorldData& world_data, const std::string& line)
+{
+  Parsed parsed;
+  const char* position = line.data();
+  const char* end = line.data() + line.size();
+
+  size_t verb_length = 0;
+  const char* verb = nextWord(&position, end, &verb_length);
+  parsed.noun = nextWord(&position, end, &parsed.noun_length);
+
+  parsed.action = world_data.verbs().find(verb, verb_length);
+  parsed.object = world_data.nouns().find(parsed.noun, parsed.noun_length);
+  return parsed;
+}
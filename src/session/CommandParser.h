@@ -0,0 +1,32 @@
+//
+// Created by Zoe on 10/11/2019.
+//
+
+#ifndef PROJECT_COMMANDPARSER_H
+#define PROJECT_COMMANDPARSER_H
+
+#include "../map/WorldData.h"
+#include <cstddef>
+#include <string>
+
+/**
+ *  Turns a line typed by the player into an action and an object.
+ *  Only the first two words are used, the verb and the noun. Both are
+ *  looked up in the world's lexicons, so nothing is copied or
+ *  allocated.
+ */
+namespace COMMAND
+{
+struct Parsed
+{
+  int action = -1; /**< Action ID, or -1 if the verb isn't known. */
+  int object = -1; /**< Object index, or -1 if there's no known noun. */
+
+  const char* noun = nullptr; /**< The noun as typed, e.g. for SAY. */
+  size_t noun_length = 0;
+};
+
+Parsed parse(const WorldData& world_data, const std::string& line);
+}
+
+#endif // PROJECT_COMMANDPARSER_H
@@ -0,0 +1,109 @@
+//
+// Created by Zoe on 04/11/2019.
+//
+
+#include "DataReader.h"
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+DATA::FileBuffer::~FileBuffer()
+{
+  release();
+}
+
+void DATA::FileBuffer::assign(const char* bytes, size_t length)
+{
+  release();
+  copy.assign(bytes, length);
+}
+
+/**
+ *   @brief   Maps a file on disk into memory
+ *   @details Falls back to reading the file on platforms without mmap.
+ *   @param   path The file to map.
+ *   @return  False if the file could not be opened.
+ */
+bool DATA::FileBuffer::map(const std::string& path)
+{
+  release();
+
+#if defined(__unix__) || defined(__APPLE__)
+  int descriptor = open(path.c_str(), O_RDONLY);
+  if (descriptor == -1)
+  {
+    return false;
+  }
+
+  struct stat info = {};
+  bool mapped = false;
+  bool empty = fstat(descriptor, &info) == 0 && info.st_size == 0;
+  if (!empty && info.st_size > 0)
+  {
+    auto length = static_cast<size_t>(info.st_size);
+    void* address =
+      mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (address != MAP_FAILED)
+    {
+      mapping = address;
+      mapping_size = length;
+      mapped = true;
+    }
+  }
+  close(descriptor);
+
+  if (mapped || empty)
+  {
+    return true;
+  }
+#endif
+
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  if (!stream)
+  {
+    return false;
+  }
+
+  const std::streamoff length = stream.tellg();
+  if (length < 0 || !stream.seekg(0))
+  {
+    return false;
+  }
+  copy.resize(static_cast<size_t>(length));
+  return length == 0 || stream.read(&copy[0], length);
+}
+
+void DATA::FileBuffer::release()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  if (mapping != nullptr)
+  {
+    munmap(mapping, mapping_size);
+  }
+#endif
+  mapping = nullptr;
+  mapping_size = 0;
+  copy.clear();
+}
+
+const char* DATA::FileBuffer::data() const
+{
+  return mapping != nullptr ? static_cast<const char*>(mapping) : copy.data();
+}
+
+size_t DATA::FileBuffer::size() const
+{
+  return mapping != nullptr ? mapping_size : copy.size();
+}
+
+DATA::FileReader DATA::diskReader(const std::string& directory)
+{
+  return [directory](const std::string& file, FileBuffer* contents) {
+    return contents->map(directory + "/" + file);
+  };
+}
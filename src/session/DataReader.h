@@ -0,0 +1,51 @@
+//
+// Created by Zoe on 04/11/2019.
+//
+
+#ifndef PROJECT_DATAREADER_H
+#define PROJECT_DATAREADER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace DATA
+{
+/**
+ *  The contents of a game data file.
+ *  Either a copy held in memory or, for files read straight from disk,
+ *  a read-only memory mapping of the file.
+ */
+class FileBuffer
+{
+ public:
+  FileBuffer() = default;
+  ~FileBuffer();
+
+  FileBuffer(const FileBuffer&) = delete;
+  FileBuffer& operator=(const FileBuffer&) = delete;
+
+  void assign(const char* bytes, size_t length);
+  bool map(const std::string& path);
+  void release();
+
+  const char* data() const;
+  size_t size() const;
+
+ private:
+  std::string copy = "";
+  void* mapping = nullptr;
+  size_t mapping_size = 0;
+};
+
+/**
+ *  Reads a game data file (e.g. "rooms.json") into contents.
+ *  Returns false if the file could not be found.
+ */
+using FileReader =
+  std::function<bool(const std::string& file, FileBuffer* contents)>;
+
+FileReader diskReader(const std::string& directory);
+};
+
+#endif // PROJECT_DATAREADER_H
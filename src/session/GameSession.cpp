@@ -0,0 +1,822 @@
+//
+// Created by Zoe on 04/11/2019.
+//
+
+#include "GameSession.h"
+#include "ActionRules.h"
+#include "CommandParser.h"
+#include "Profiler.h"
+#include "SaveGame.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+GameSession::GameSession(DATA::FileReader reader) :
+  read_file(std::move(reader))
+{
+  seed(std::random_device{}());
+}
+
+/**
+ *   @brief   Seeds the session's random number generator
+ *   @details Each session owns its generator, so sessions never
+ *            share random state when run on different threads.
+ *   @param   value The seed.
+ */
+void GameSession::seed(unsigned int value)
+{
+  state.random_engine.seed(value);
+}
+
+/**
+ *   @brief   Loads the world data for the session
+ *   @details Sessions copied from this one share the loaded data.
+ *   @return  True if every data file loaded.
+ */
+bool GameSession::load()
+{
+  auto world_data = std::make_shared<WorldData>();
+  bool loaded = world_data->load(read_file);
+  data = world_data;
+  return loaded;
+}
+
+/**
+ *   @brief   Starts a new game
+ *   @details Copies the world's starting state into the session, no
+ *            game data is read or parsed. The random engine carries on
+ *            from the previous game. Starts a new log.
+ */
+void GameSession::reset()
+{
+  std::minstd_rand random_engine = state.random_engine;
+  uint32_t revision = state.revision;
+  state = data->startingState();
+  state.random_engine = random_engine;
+  state.revision = revision + 1;
+
+  log_engine = random_engine;
+  log_save.clear();
+  log_commands.clear();
+  journal.clear();
+
+  current_action = -1;
+  current_action_object = -1;
+
+  say_value = "";
+  action_response = "The gate slams shut behind you.";
+  response_revision += 1;
+}
+
+/**
+ *   @brief   Runs a single command against the session
+ *   @details Parses the command, checks it can be performed and
+ *            applies it to the world, then checks for the end of
+ *            the game. Commands are ignored once the game is over.
+ *   @param   command The line typed by the player, e.g. "GET ROPE".
+ *   @return  The response to show the player.
+ */
+const std::string& GameSession::step(const std::string& command)
+{
+  PROFILER::Zone zone("step");
+  if (state.game_over)
+  {
+    return action_response;
+  }
+  if (log_commands.size() < log_limit)
+  {
+    log_commands.push_back(command);
+  }
+
+  current_action = -1;
+  current_action_object = -1;
+  getAction(command);
+
+  if (current_action == DATA::UNDO_ACTION)
+  {
+    undo();
+  }
+  else if (current_action != -1 && validateInput())
+  {
+    journal.begin(state);
+    runAction();
+
+    current_action = -1;
+    current_action_object = -1;
+
+    checkEndState();
+    journal.end(state);
+  }
+
+  response_revision += 1;
+  return action_response;
+}
+
+/**
+ *   @brief   Would a command pass its preconditions
+ *   @details Nothing in the session changes, not even the response,
+ *            a command that isn't accepted would only have been
+ *            answered with an error.
+ *   @param   command The line typed by the player, e.g. "GET ROPE".
+ */
+bool GameSession::accepts(const std::string& command)
+{
+  // getAction() sets these for the command that follows, keep the last
+  std::string response = std::move(action_response);
+  std::string said = std::move(say_value);
+  int steps = undo_steps;
+
+  getAction(command);
+  bool valid = current_action != -1 &&
+               RULES::check(*data,
+                            state,
+                            &current_action,
+                            current_action_object) == RULES::VALID;
+
+  current_action = -1;
+  current_action_object = -1;
+  action_response = std::move(response);
+  say_value = std::move(said);
+  undo_steps = steps;
+  return valid;
+}
+
+const std::string& GameSession::response()
+{
+  return action_response;
+}
+
+bool GameSession::gameOver()
+{
+  return state.game_over;
+}
+
+int GameSession::playerScore()
+{
+  return state.score;
+}
+
+/**
+ *   @brief   Counts changes to the world
+ *   @details Changes whenever something the player can see in the
+ *            world changes, e.g. a move, an exit opening or an object
+ *            being revealed, picked up or dropped.
+ */
+uint32_t GameSession::worldRevision() const
+{
+  return state.revision;
+}
+
+/**
+ *   @brief   Counts changes to the response
+ */
+uint32_t GameSession::responseRevision() const
+{
+  return response_revision;
+}
+
+/**
+ *   @brief   Starts or stops recording the commands run
+ *   @details Nothing is recorded by default, so sessions that run many
+ *            commands, e.g. the solver's, don't keep them all.
+ *   @param   max_commands The most commands kept, later ones aren't
+ *            recorded. 0 stops recording.
+ */
+void GameSession::recordLog(size_t max_commands)
+{
+  log_limit = max_commands;
+}
+
+/**
+ *   @brief   The commands run since the game started
+ *   @details Play the log back with REPLAY::transcript() to see the
+ *            game again exactly, or up to the limit recordLog() set if
+ *            more commands were run. A game carried on with loadGame()
+ *            is logged from the save.
+ */
+REPLAY::Log GameSession::log() const
+{
+  REPLAY::Log log;
+  log.seed = REPLAY::engineSeed(log_engine);
+  log.save = log_save;
+  log.commands = log_commands;
+  return log;
+}
+
+/**
+ *   @brief   Everything about the game in progress
+ *   @details Pass to restore() to carry on from this point.
+ */
+const SessionState& GameSession::snapshot() const
+{
+  return state;
+}
+
+/**
+ *   @brief   Carries on a game from a snapshot
+ *   @details The snapshot must be from a session playing the same world.
+ *            While recording, the log starts again from a save of the
+ *            snapshot, so it plays back from here.
+ *   @param   snapshot A state from snapshot().
+ */
+void GameSession::restore(const SessionState& snapshot)
+{
+  uint32_t revision = state.revision;
+  state = snapshot;
+  state.revision = revision + 1;
+  response_revision += 1;
+
+  log_engine = state.random_engine;
+  log_save.clear();
+  if (log_limit > 0)
+  {
+    log_save = saveGame();
+  }
+  log_commands.clear();
+  journal.clear();
+}
+
+/**
+ *   @brief   Takes back the last commands that changed something
+ *   @details Each command takes the same time to take back however
+ *            many are kept. The oldest are forgotten once the journal
+ *            is full.
+ *   @param   steps The number of commands to take back.
+ *   @return  The number taken back, fewer if there weren't enough.
+ */
+int GameSession::rewind(int steps)
+{
+  Map map(*data, state);
+  int taken_back = 0;
+  while (taken_back < steps && journal.undo(&map, &state))
+  {
+    taken_back += 1;
+  }
+  return taken_back;
+}
+
+/**
+ *   @brief   The number of commands that can be taken back
+ */
+int GameSession::undoSteps() const
+{
+  return journal.steps();
+}
+
+/**
+ *   @brief   Saves the game in progress
+ *   @details See SAVE::write(). Takes a few microseconds for the
+ *            stock world, so it can be called after every command.
+ */
+std::vector<char> GameSession::saveGame() const
+{
+  return SAVE::write(state, action_response);
+}
+
+/**
+ *   @brief   Carries on a game from a save
+ *   @details The session must have loaded the world the game was saved
+ *            in. The session is unchanged if the save isn't valid. The
+ *            log starts again from the save.
+ *   @param   save The bytes from saveGame().
+ *   @param   length The size of the save.
+ *   @return  True if the save was valid and loaded.
+ */
+bool GameSession::loadGame(const char* save, size_t length)
+{
+  SessionState loaded;
+  std::string response;
+  if (!SAVE::read(save, length, *data, &loaded, &response))
+  {
+    return false;
+  }
+
+  restore(loaded);
+  current_action = -1;
+  current_action_object = -1;
+  say_value = "";
+  action_response = response;
+  log_save.assign(save, save + length);
+  return true;
+}
+
+/**
+ *   @brief   The world the session is playing
+ */
+const WorldData& GameSession::worldData() const
+{
+  return *data;
+}
+
+/**
+ *   @brief   The world, to share with a reload
+ */
+std::shared_ptr<const WorldData> GameSession::sharedWorldData() const
+{
+  return data;
+}
+
+/**
+ *   @brief   Carries the game on in a new version of the world
+ *   @details See WorldData::migrate(). The log and the journal restart
+ *            from here, as the commands before can't be replayed in
+ *            the new world. The log starts from a save of the migrated
+ *            game, so it plays back in the new world.
+ *   @param   world_data The new world, e.g. with a file reloaded.
+ */
+void GameSession::reload(std::shared_ptr<const WorldData> world_data)
+{
+  SessionState migrated = world_data->migrate(state, *data);
+  data = std::move(world_data);
+  restore(migrated);
+}
+
+/**
+ *   @brief   The session's view of the world
+ *   @details The view refers to the session, it must not outlive it.
+ */
+Map GameSession::world()
+{
+  return map();
+}
+
+Map GameSession::map()
+{
+  return Map(*data, state, &journal);
+}
+
+void GameSession::getAction(const std::string& command)
+{
+  PROFILER::Zone zone("getAction");
+  COMMAND::Parsed parsed = COMMAND::parse(*data, command);
+  current_action = parsed.action;
+
+  if (current_action == -1)
+  {
+    action_response = "This is not a valid command.";
+  }
+  if (current_action == 15)
+  {
+    current_action_object = 0;
+    say_value.assign(parsed.noun, parsed.noun_length);
+  }
+  else if (current_action == DATA::UNDO_ACTION)
+  {
+    current_action_object = -1;
+    std::string count(parsed.noun, parsed.noun_length);
+    long steps = std::strtol(count.c_str(), nullptr, 10);
+    steps = std::min(steps, static_cast<long>(undoSteps()));
+    undo_steps = static_cast<int>(std::max(1L, steps));
+  }
+  else
+  {
+    current_action_object = parsed.object;
+  }
+}
+
+void GameSession::runAction()
+{
+  PROFILER::Zone zone("runAction", current_action);
+  Map map = this->map();
+
+  action_response = data->action(current_action).output();
+
+  if (checkFrozen())
+  {
+    return;
+  }
+
+  int direction = data->actionDirection(current_action);
+  if (direction != -1)
+  {
+    action_response = map.move(direction);
+  }
+  else
+  {
+    switch (current_action)
+    {
+      case (0):
+      {
+        showActions();
+        break;
+      }
+      case (1):
+      {
+        showInventory();
+        break;
+      }
+      case (6):
+      case (7):
+      {
+        addObjectToInventory();
+
+        if (current_action_object + 1 == 15 &&
+            map.currentRoom().roomID() == 47)
+        {
+          map.changeExits(47, 0, false);
+          map.changeExits(47, 2, true);
+        }
+        break;
+      }
+      case (8):
+      {
+        examineObject();
+        break;
+      }
+      case (9):
+      {
+        removeObjectFromInventory();
+        break;
+      }
+      case (10):
+      {
+        showScore();
+        break;
+      }
+      case (11):
+      {
+        if (map.hasExit(28, DATA::SOUTH))
+        {
+          action_response = "You've already done this action.";
+        }
+        else
+        {
+          action_response = data->action(11).output();
+          map.changeExits(28, 2, true);
+        }
+        break;
+      }
+      case (12):
+      {
+        if (map.objectHidden(16))
+        {
+          action_response = data->action(12).output();
+          map.revealObject(16);
+        }
+        else
+        {
+          action_response = "You've already done this action.";
+        }
+        break;
+      }
+      case (15):
+      {
+        say();
+        break;
+      }
+      case (16):
+      {
+        if (map.hasExit(31, DATA::WEST))
+        {
+          action_response = "You've already done this action.";
+        }
+        else if (map.currentRoom().roomID() == 30 ||
+                 map.currentRoom().roomID() == 31)
+        {
+          map.changeExits(31, 3, true);
+          map.changeExits(30, 1, true);
+        }
+        break;
+      }
+      case (17):
+      {
+        if (map.currentRoom().roomID() == 7)
+        {
+          action_response = "TIMBERRRRR!";
+          state.axed_tree = true;
+        }
+        else if (map.currentRoom().roomID() == 43)
+        {
+          if (map.hasExit(43, DATA::NORTH))
+          {
+            action_response = "You've already done this action.";
+          }
+          else
+          {
+            action_response = "You broke the thin wall.\nA secret room to "
+                              "the NORTH appears.";
+            map.changeExits(43, 0, true);
+          }
+        }
+        else
+        {
+          action_response = data->action(current_action).output();
+        }
+        break;
+      }
+      case (18):
+      {
+        if (state.axed_tree)
+        {
+          action_response = "You cut the tree down, you can't climb it "
+                            "now.";
+        }
+        else
+        {
+          if (state.up_tree)
+          {
+            action_response = "You climb down the tree.";
+            state.up_tree = false;
+          }
+          else
+          {
+            if (!state.inventory.has(3))
+            {
+              action_response = "You fall out of the tree! OUCH!";
+            }
+            else
+            {
+              action_response = data->action(current_action).output();
+              state.up_tree = true;
+            }
+          }
+        }
+        break;
+      }
+      case (19):
+      {
+        action_response = map.removeBats();
+        break;
+      }
+      case (20):
+      {
+        action_response = map.removeGhosts();
+        break;
+      }
+      case (21):
+      {
+        action_response = map.lightCandle();
+        break;
+      }
+      case (22):
+      {
+        map.unlightCandle();
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+void GameSession::checkEndState()
+{
+  Map map = this->map();
+
+  if (!state.in_end_state &&
+      state.inventory.treasures == data->treasureCount())
+  {
+    map.changeExits(41, 2, true);
+    state.in_end_state = true;
+  }
+
+  if (state.in_end_state)
+  {
+    if (map.currentRoom().roomID() == 57)
+    {
+      state.game_over = true;
+      setScore();
+    }
+    else
+    {
+      action_response += "\nYou have collected all the treasures!\nHead "
+                         "back to the gate to see your score.";
+    }
+  }
+}
+
+/**
+ *   @brief   Updates the score shown to the player
+ *   @details Treasures are worth 10 and other objects 1. The inventory
+ *            keeps the total as objects are picked up and put down.
+ */
+void GameSession::setScore()
+{
+  state.score = state.inventory.points;
+}
+
+bool GameSession::validateInput()
+{
+  switch (RULES::check(*data, state, &current_action, current_action_object))
+  {
+    case RULES::NEEDS_OBJECT:
+      action_response = "You need to say a valid object with\nthis action.";
+      return false;
+    case RULES::WRONG_OBJECT:
+      action_response = "You can't do that.";
+      return false;
+    case RULES::MISSING_OBJECTS:
+      action_response = "You don't have the required objects\nto "
+                        "complete this action.";
+      return false;
+    case RULES::WRONG_ROOM:
+      action_response = "You can't do this here.";
+      return false;
+    default:
+      return true;
+  }
+}
+
+void GameSession::showActions()
+{
+  for (int i = 0; i < data->actionCount(); i++)
+  {
+    if (i % 7 == 0 && i != 0)
+    {
+      action_response += "\n";
+    }
+
+    if (i != 12 && i != 14)
+    {
+      action_response += data->action(i).actionVerb() + ", ";
+    }
+  }
+}
+
+void GameSession::showInventory()
+{
+  Map map = this->map();
+
+  for (int i = 0; i < state.inventory.count; i++)
+  {
+    if (i % 4 == 0 && i != 0)
+    {
+      action_response += "\n";
+    }
+    action_response +=
+      map.object(state.inventory.objects[i]).objectName() + ", ";
+  }
+}
+
+void GameSession::addObjectToInventory()
+{
+  Map map = this->map();
+
+  if (map.objectHere(current_action_object) &&
+      map.object(current_action_object).collectible() &&
+      !map.objectHidden(current_action_object))
+  {
+    map.moveObject(current_action_object, DATA::CARRIED);
+    state.inventory.add(current_action_object,
+                        map.object(current_action_object).treasure());
+    journal.objectCarried(current_action_object);
+    action_response =
+      "You picked up " + map.object(current_action_object).objectName();
+  }
+  else if (map.object(current_action_object).collectible())
+  {
+    action_response = "There is no " +
+                      map.object(current_action_object).objectName() +
+                      " in this room";
+  }
+  else
+  {
+    action_response =
+      "You cannot pickup " + map.object(current_action_object).objectName();
+  }
+}
+
+void GameSession::removeObjectFromInventory()
+{
+  Map map = this->map();
+
+  if (!state.inventory.has(current_action_object))
+  {
+    action_response =
+      "You aren't carrying " + map.object(current_action_object).objectName();
+  }
+  else
+  {
+    map.moveObject(current_action_object, state.current_room);
+    journal.objectDropped(current_action_object,
+                          state.inventory.position(current_action_object));
+    state.inventory.remove(current_action_object,
+                           map.object(current_action_object).treasure());
+    action_response =
+      "You dropped " + map.object(current_action_object).objectName();
+  }
+}
+
+void GameSession::examineObject()
+{
+  Map map = this->map();
+
+  if ((map.objectHere(current_action_object) ||
+       state.inventory.has(current_action_object)) &&
+      !map.objectHidden(current_action_object))
+  {
+    action_response = map.object(current_action_object).examine();
+  }
+  else
+  {
+    action_response =
+      "There is no " + map.object(current_action_object).objectName() + " here";
+  }
+
+  if (current_action_object + 1 == 22 && map.objectHidden(17))
+  {
+    map.revealObject(17);
+    action_response += "\nA key is revealed!";
+  }
+  else if (current_action_object + 1 == 20)
+  {
+    action_response = map.object(current_action_object).examine();
+  }
+}
+
+void GameSession::showScore()
+{
+  setScore();
+  action_response = "Your score is: " + std::to_string(state.score);
+}
+
+void GameSession::say()
+{
+  Map map = this->map();
+
+  action_response = "You said '" + say_value + "'";
+
+  if (say_value == DATA::MAGIC_WORD)
+  {
+    action_response += "\n*MAGIC OCCURS*";
+    if (map.currentRoom().roomID() == 45)
+    {
+      action_response += "\nThe magical barrier falls";
+      map.changeExits(45, 3, true);
+    }
+    else
+    {
+      map.magicRandomRoom();
+    }
+  }
+}
+
+/**
+ *   @brief   Takes back commands, e.g. UNDO or UNDO 5
+ *   @details Works even when the player is frozen.
+ */
+void GameSession::undo()
+{
+  int taken_back = rewind(undo_steps);
+  if (taken_back == 0)
+  {
+    action_response = "There is nothing to undo.";
+  }
+  else
+  {
+    action_response = "You take back " + std::to_string(taken_back) +
+                      (taken_back == 1 ? " move." : " moves.");
+  }
+}
+
+bool GameSession::checkFrozen()
+{
+  Map map = this->map();
+
+  if (map.currentRoom().roomID() == 13 && map.objectHere(22))
+  {
+    action_response = "The bats frighten you,\nyou're too scared to do "
+                      "anything but run!";
+    if (current_action == 5)
+    {
+      action_response = map.move(DATA::WEST);
+      action_response = "You flee.";
+    }
+    else if (current_action == 19)
+    {
+      action_response = map.removeBats();
+    }
+    return true;
+  }
+  if (map.currentRoom().roomID() == 52 && map.objectHere(23))
+  {
+    action_response = "The ghosts frighten you,\nyou're too scared to do "
+                      "anything but run!";
+    if (current_action == 2)
+    {
+      action_response = map.move(DATA::NORTH);
+      action_response = "You flee.";
+    }
+    else if (current_action == 20)
+    {
+      action_response = map.removeGhosts();
+    }
+    return true;
+  }
+
+  if ((map.currentRoom().roomID() == 61 || map.currentRoom().roomID() == 62) &&
+      state.inventory.has(14))
+  {
+    action_response = "The boat get's stuck,\nyou have to leave it behind.";
+    if (current_action == 9 && current_action_object + 1 == 15)
+    {
+      removeObjectFromInventory();
+      action_response = "You get out of the boat.";
+      map.changeExits(47, 0, true);
+      map.changeExits(47, 2, false);
+    }
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,106 @@
+//
+// Created by Zoe on 04/11/2019.
+//
+
+#ifndef PROJECT_GAMESESSION_H
+#define PROJECT_GAMESESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../game/GameConstants.h"
+#include "../map/Map.h"
+#include "../map/WorldData.h"
+#include "DataReader.h"
+#include "Journal.h"
+#include "Replay.h"
+#include "SessionState.h"
+
+/**
+ *  A single play-through of the adventure.
+ *  Shares the read-only WorldData with every other session and keeps
+ *  its own SessionState, then applies the game rules to each command.
+ *  It has no dependency on the renderer so it can be run headless.
+ */
+class GameSession
+{
+ public:
+  explicit GameSession(DATA::FileReader reader);
+  ~GameSession() = default;
+
+  bool load();
+  void reset();
+  void seed(unsigned int value);
+
+  const std::string& step(const std::string& command);
+  bool accepts(const std::string& command);
+
+  const std::string& response();
+  bool gameOver();
+  int playerScore();
+  Map world();
+  const WorldData& worldData() const;
+  std::shared_ptr<const WorldData> sharedWorldData() const;
+  void reload(std::shared_ptr<const WorldData> world_data);
+
+  uint32_t worldRevision() const;
+  uint32_t responseRevision() const;
+
+  void recordLog(size_t max_commands);
+  REPLAY::Log log() const;
+  const SessionState& snapshot() const;
+  void restore(const SessionState& snapshot);
+
+  int rewind(int steps);
+  int undoSteps() const;
+
+  std::vector<char> saveGame() const;
+  bool loadGame(const char* save, size_t length);
+
+ private:
+  Map map();
+
+  void checkEndState();
+  void setScore();
+  bool validateInput();
+  void getAction(const std::string& command);
+  void runAction();
+
+  void showActions();
+  void showInventory();
+
+  void addObjectToInventory();
+  void removeObjectFromInventory();
+
+  void examineObject();
+  void showScore();
+  void say();
+  void undo();
+  bool checkFrozen();
+
+  DATA::FileReader read_file;
+
+  std::shared_ptr<const WorldData> data;
+  SessionState state = SessionState();
+
+  int current_action = -1;
+  int current_action_object = -1;
+
+  Journal journal;
+  int undo_steps = 1; /**< Commands an UNDO takes back. */
+
+  std::minstd_rand log_engine;           /**< The engine when the log began. */
+  std::vector<char> log_save;            /**< The save it began from. */
+  std::vector<std::string> log_commands; /**< Commands run since then. */
+  size_t log_limit = 0;                  /**< Most commands logged. */
+
+  std::string say_value = "";
+  std::string action_response = "";
+  uint32_t response_revision = 0;
+};
+
+#endif // PROJECT_GAMESESSION_H
@@ -0,0 +1,108 @@
+//
+// Created by Zoe on 12/11/2019.
+//
+
+#include "Inventory.h"
+
+namespace
+{
+const int TREASURE_POINTS = 10;
+const int OBJECT_POINTS = 1;
+}
+
+/**
+ *   @brief   Empties the inventory
+ *   @param   object_num The number of objects in the world.
+ */
+void Inventory::clear(int object_num)
+{
+  objects.assign(static_cast<size_t>(object_num), -1);
+  count = 0;
+  carried.assign(static_cast<size_t>(object_num), 0);
+  points = 0;
+  treasures = 0;
+}
+
+bool Inventory::has(int object) const
+{
+  return object >= 0 && static_cast<size_t>(object) < carried.size() &&
+         carried[static_cast<size_t>(object)] != 0;
+}
+
+/**
+ *   @brief   Where an object is in the inventory
+ *   @return  The object's position, or -1 if it isn't being carried.
+ */
+int Inventory::position(int object) const
+{
+  for (int i = 0; i < count; i++)
+  {
+    if (objects[i] == object)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/**
+ *   @brief   Adds an object to the end of the inventory
+ *   @param   object The object's index.
+ *   @param   treasure True if the object is a treasure.
+ */
+void Inventory::add(int object, bool treasure)
+{
+  objects[count] = object;
+  count += 1;
+  carried[object] = 1;
+
+  points += treasure ? TREASURE_POINTS : OBJECT_POINTS;
+  treasures += treasure ? 1 : 0;
+}
+
+/**
+ *   @brief   Adds an object at a position, moving the others along
+ *   @param   position Where to put the object, from 0 to count.
+ *   @param   object The object's index.
+ *   @param   treasure True if the object is a treasure.
+ */
+void Inventory::insert(int position, int object, bool treasure)
+{
+  for (int i = count; i > position; i--)
+  {
+    objects[i] = objects[i - 1];
+  }
+  objects[position] = object;
+  count += 1;
+  carried[object] = 1;
+
+  points += treasure ? TREASURE_POINTS : OBJECT_POINTS;
+  treasures += treasure ? 1 : 0;
+}
+
+/**
+ *   @brief   Removes an object, keeping the others in order
+ *   @param   object The object's index.
+ *   @param   treasure True if the object is a treasure.
+ *   @return  False if the object wasn't being carried.
+ */
+bool Inventory::remove(int object, bool treasure)
+{
+  if (!has(object))
+  {
+    return false;
+  }
+
+  int index = position(object);
+  for (int i = index; i < count - 1; i++)
+  {
+    objects[i] = objects[i + 1];
+  }
+  count -= 1;
+  objects[count] = -1;
+  carried[object] = 0;
+
+  points -= treasure ? TREASURE_POINTS : OBJECT_POINTS;
+  treasures -= treasure ? 1 : 0;
+  return true;
+}
@@ -0,0 +1,36 @@
+//
+// Created by Zoe on 12/11/2019.
+//
+
+#ifndef PROJECT_INVENTORY_H
+#define PROJECT_INVENTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ *  The objects a player is carrying.
+ *  A flag per object answers "am I carrying X" in constant time and the
+ *  list keeps the order objects were picked up in, for listing them.
+ *  The score and the number of treasures carried are kept up to date as
+ *  objects are picked up and put down.
+ */
+struct Inventory
+{
+  std::vector<int32_t> objects; /**< Object indexes, in pickup order. */
+  int count = 0;                /**< Number of objects carried. */
+  std::vector<uint8_t> carried; /**< Per object, 1 if carried. */
+
+  int points = 0;    /**< Score for the objects carried. */
+  int treasures = 0; /**< Number of treasures carried. */
+
+  void clear(int object_num);
+  bool has(int object) const;
+  int position(int object) const;
+  void add(int object, bool treasure);
+  void insert(int position, int object, bool treasure);
+  bool remove(int object, bool treasure);
+};
+
+#endif // PROJECT_INVENTORY_H
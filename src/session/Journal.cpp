@@ -0,0 +1,215 @@
+//
+// Created by Zoe on 17/11/2019.
+//
+
+#include "Journal.h"
+#include "../map/Map.h"
+#include "SessionState.h"
+
+/**
+ *   @brief   Forgets every step
+ *   @details Call whenever the state is replaced, e.g. a new game.
+ */
+void Journal::clear()
+{
+  step_begin = 0;
+  step_end = 0;
+  change_end = 0;
+  recording = false;
+}
+
+/**
+ *   @brief   Starts a step, call before a command changes anything
+ *   @details The rings are only allocated once the first step begins,
+ *            so sessions that never play, e.g. prototypes, stay small.
+ */
+void Journal::begin(const SessionState& state)
+{
+  if (step_ring.empty())
+  {
+    step_ring.resize(STEP_NUM);
+    change_ring.resize(CHANGE_NUM);
+  }
+  replaced_oldest = step_end - step_begin == STEP_NUM;
+  if (replaced_oldest)
+  {
+    replaced = step_ring[step_end % STEP_NUM];
+    step_begin += 1;
+  }
+
+  Step& step = step_ring[step_end % STEP_NUM];
+  step.current_room = state.current_room;
+  step.light_amount = state.light_amount;
+  step.score = state.score;
+  step.light_ignited = state.light_ignited;
+  step.axed_tree = state.axed_tree;
+  step.up_tree = state.up_tree;
+  step.in_end_state = state.in_end_state;
+  step.game_over = state.game_over;
+  step.random_engine = state.random_engine;
+  step.first_change = change_end;
+
+  step_end += 1;
+  recording = true;
+}
+
+/**
+ *   @brief   Ends the step, call once the command is done
+ *   @details A command that changed nothing isn't kept, so UNDO takes
+ *            back the last command that did something. If the ring was
+ *            full, the oldest step it wrote over is put back.
+ */
+void Journal::end(const SessionState& state)
+{
+  if (recording)
+  {
+    const Step& step = step_ring[(step_end - 1) % STEP_NUM];
+    if (step.first_change == change_end && samePlayer(step, state))
+    {
+      step_end -= 1;
+      if (replaced_oldest)
+      {
+        step_ring[step_end % STEP_NUM] = replaced;
+        step_begin -= 1;
+      }
+    }
+  }
+  recording = false;
+}
+
+/**
+ *   @brief   The number of steps that can be taken back
+ */
+int Journal::steps() const
+{
+  return static_cast<int>(step_end - step_begin);
+}
+
+/**
+ *   @brief   Takes back the newest step
+ *   @details Puts back every change in the opposite order to how they
+ *            were made, then the player's own values.
+ *   @param   map The session's view of the world.
+ *   @param   state The session's state.
+ *   @return  False if there was no step to take back.
+ */
+bool Journal::undo(Map* map, SessionState* state)
+{
+  if (recording || step_end == step_begin)
+  {
+    return false;
+  }
+
+  step_end -= 1;
+  const Step& step = step_ring[step_end % STEP_NUM];
+  while (change_end != step.first_change)
+  {
+    change_end -= 1;
+    const Change& change = change_ring[change_end % CHANGE_NUM];
+    const auto index = static_cast<size_t>(change.index);
+    switch (change.kind)
+    {
+      case Kind::EXITS:
+        state->exits[index] = static_cast<uint16_t>(change.value);
+        break;
+      case Kind::HIDDEN:
+        state->hidden_objects[index] = static_cast<uint8_t>(change.value);
+        break;
+      case Kind::LOCATION:
+        map->placeObject(change.index, change.value, change.extra);
+        break;
+      case Kind::CARRIED:
+        state->inventory.remove(change.index,
+                                map->object(change.index).treasure());
+        break;
+      case Kind::DROPPED:
+        state->inventory.insert(
+          change.extra, change.index, map->object(change.index).treasure());
+        break;
+    }
+  }
+
+  state->current_room = step.current_room;
+  state->light_amount = step.light_amount;
+  state->score = step.score;
+  state->light_ignited = step.light_ignited;
+  state->axed_tree = step.axed_tree;
+  state->up_tree = step.up_tree;
+  state->in_end_state = step.in_end_state;
+  state->game_over = step.game_over;
+  state->random_engine = step.random_engine;
+  state->revision += 1;
+  return true;
+}
+
+void Journal::exitsChanged(int room, uint16_t old_exits)
+{
+  record(Kind::EXITS, room, old_exits, 0);
+}
+
+void Journal::hiddenChanged(int object, uint8_t old_hidden)
+{
+  record(Kind::HIDDEN, object, old_hidden, 0);
+}
+
+/**
+ *   @param   object The object's index.
+ *   @param   old_location Where it was.
+ *   @param   old_prev The object before it in its room, or -1.
+ */
+void Journal::objectMoved(int object, int32_t old_location, int32_t old_prev)
+{
+  record(Kind::LOCATION, object, old_location, old_prev);
+}
+
+void Journal::objectCarried(int object)
+{
+  record(Kind::CARRIED, object, 0, 0);
+}
+
+/**
+ *   @param   object The object's index.
+ *   @param   old_position Where it was in the inventory.
+ */
+void Journal::objectDropped(int object, int old_position)
+{
+  record(Kind::DROPPED, object, 0, old_position);
+}
+
+bool Journal::samePlayer(const Step& step, const SessionState& state)
+{
+  return step.current_room == state.current_room &&
+         step.light_amount == state.light_amount &&
+         step.score == state.score &&
+         step.light_ignited == state.light_ignited &&
+         step.axed_tree == state.axed_tree && step.up_tree == state.up_tree &&
+         step.in_end_state == state.in_end_state &&
+         step.game_over == state.game_over &&
+         step.random_engine == state.random_engine;
+}
+
+/**
+ *   @brief   Keeps a change in the current step
+ *   @details Steps that would lose a change to the ring wrapping are
+ *            forgotten, oldest first. A change made outside a step
+ *            can't be taken back, so every earlier step is forgotten.
+ */
+void Journal::record(Kind kind, int32_t index, int32_t value, int32_t extra)
+{
+  if (!recording)
+  {
+    clear();
+    return;
+  }
+
+  change_ring[change_end % CHANGE_NUM] = { kind, index, value, extra };
+  change_end += 1;
+
+  while (step_end != step_begin &&
+         change_end - step_ring[step_begin % STEP_NUM].first_change >
+           CHANGE_NUM)
+  {
+    step_begin += 1;
+  }
+  recording = step_end != step_begin;
+}
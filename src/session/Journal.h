@@ -0,0 +1,89 @@
+//
+// Created by Zoe on 17/11/2019.
+//
+
+#ifndef PROJECT_JOURNAL_H
+#define PROJECT_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+class Map;
+struct SessionState;
+
+/**
+ *  Remembers how to take back the last commands, for UNDO.
+ *  Each command is a step. A step keeps the player's own values, e.g.
+ *  the room, the light and the flags, and every change to the world's
+ *  tables is kept as a small change holding the value it replaced.
+ *  Steps and changes live in fixed size rings, so a session's journal
+ *  never grows and the oldest steps are forgotten first. Taking back a
+ *  step only touches what that step changed.
+ */
+class Journal
+{
+ public:
+  static const uint32_t STEP_NUM = 256;
+  static const uint32_t CHANGE_NUM = 1024;
+
+  void clear();
+  void begin(const SessionState& state);
+  void end(const SessionState& state);
+  int steps() const;
+  bool undo(Map* map, SessionState* state);
+
+  void exitsChanged(int room, uint16_t old_exits);
+  void hiddenChanged(int object, uint8_t old_hidden);
+  void objectMoved(int object, int32_t old_location, int32_t old_prev);
+  void objectCarried(int object);
+  void objectDropped(int object, int old_position);
+
+ private:
+  enum class Kind : int32_t
+  {
+    EXITS,
+    HIDDEN,
+    LOCATION,
+    CARRIED,
+    DROPPED
+  };
+
+  struct Change
+  {
+    Kind kind;
+    int32_t index; /**< The room or object changed. */
+    int32_t value; /**< The value it replaced. */
+    int32_t extra; /**< The object before it, or its inventory position. */
+  };
+
+  struct Step
+  {
+    int current_room;
+    int light_amount;
+    int score;
+    bool light_ignited;
+    bool axed_tree;
+    bool up_tree;
+    bool in_end_state;
+    bool game_over;
+    std::minstd_rand random_engine;
+    uint32_t first_change; /**< Count of changes when the step began. */
+  };
+
+  static bool samePlayer(const Step& step, const SessionState& state);
+  void record(Kind kind, int32_t index, int32_t value, int32_t extra);
+
+  std::vector<Step> step_ring;
+  std::vector<Change> change_ring;
+  uint32_t step_begin = 0; /**< The oldest step kept. */
+  uint32_t step_end = 0;   /**< One past the newest step. */
+  uint32_t change_end = 0; /**< One past the newest change. */
+  bool recording = false;  /**< A step has begun and is still kept. */
+
+  Step replaced = Step();       /**< The step begin() wrote over. */
+  bool replaced_oldest = false; /**< The step ring was full at begin(). */
+};
+
+#endif // PROJECT_JOURNAL_H
@@ -0,0 +1,230 @@
+//
+// Created by Zoe on 23/11/2019.
+//
+
+#include "Profiler.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> PROFILER::active(false);
+
+namespace
+{
+/**
+ *  One recorded zone. The fields are written by the ring's thread and
+ *  may be read by another at the same time, so each is atomic. The
+ *  sequence is 0 while the slot is being written, then the index of
+ *  the zone plus one, so a reader can tell a zone it read whole.
+ */
+struct Slot
+{
+  std::atomic<uint64_t> sequence{ 0 };
+  std::atomic<const char*> name{ nullptr };
+  std::atomic<int> detail{ -1 };
+  std::atomic<int64_t> start{ 0 };
+  std::atomic<int64_t> end{ 0 };
+};
+
+struct Ring
+{
+  std::array<Slot, PROFILER::RING_SIZE> slots;
+  std::atomic<uint64_t> head{ 0 }; /**< Zones ever recorded. */
+  int thread = 0;
+};
+
+struct Event
+{
+  const char* name;
+  int detail;
+  int64_t start;
+  int64_t end;
+  int thread;
+};
+
+// every thread's ring, kept after the thread exits so its zones can
+// still be read
+std::mutex rings_mutex;
+std::vector<std::shared_ptr<Ring>> rings;
+
+Ring& threadRing()
+{
+  thread_local std::shared_ptr<Ring> ring;
+  if (!ring)
+  {
+    ring = std::make_shared<Ring>();
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    ring->thread = static_cast<int>(rings.size()) + 1;
+    rings.push_back(ring);
+  }
+  return *ring;
+}
+
+/**
+ *   @brief   Copies the zones every ring holds
+ *   @details Zones overwritten while they were being copied are left
+ *            out. Only the copy is made under the lock, the threads
+ *            recording are never held up.
+ */
+std::vector<Event> collect(const char* only_name)
+{
+  std::vector<Event> events;
+  std::lock_guard<std::mutex> lock(rings_mutex);
+  for (const auto& ring : rings)
+  {
+    const uint64_t head = ring->head.load(std::memory_order_acquire);
+    const uint64_t first =
+      head > PROFILER::RING_SIZE ? head - PROFILER::RING_SIZE : 0;
+    for (uint64_t i = first; i < head; i++)
+    {
+      const Slot& slot = ring->slots[i % PROFILER::RING_SIZE];
+      const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+      Event event = { slot.name.load(std::memory_order_relaxed),
+                      slot.detail.load(std::memory_order_relaxed),
+                      slot.start.load(std::memory_order_relaxed),
+                      slot.end.load(std::memory_order_relaxed),
+                      ring->thread };
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (before != i + 1 ||
+          slot.sequence.load(std::memory_order_relaxed) != before)
+      {
+        continue;
+      }
+      if (only_name == nullptr || std::strcmp(event.name, only_name) == 0)
+      {
+        events.push_back(event);
+      }
+    }
+  }
+  return events;
+}
+
+void appendEscaped(std::string* out, const char* text)
+{
+  for (; *text != '\0'; text++)
+  {
+    if (*text == '"' || *text == '\\')
+    {
+      *out += '\\';
+    }
+    *out += static_cast<unsigned char>(*text) < 0x20 ? ' ' : *text;
+  }
+}
+}
+
+/**
+ *   @brief   Starts or stops recording zones
+ *   @details Zones already recorded are kept.
+ */
+void PROFILER::enable(bool on)
+{
+  active.store(on, std::memory_order_relaxed);
+}
+
+/**
+ *   @brief   Nanoseconds since the profiler was first used
+ */
+int64_t PROFILER::now()
+{
+  using Clock = std::chrono::steady_clock;
+  static const Clock::time_point epoch = Clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                              epoch)
+    .count();
+}
+
+/**
+ *   @brief   Adds a zone to the calling thread's ring
+ *   @details For zones that aren't a scope, e.g. the time between two
+ *            frames. The oldest zone is overwritten once the ring is
+ *            full.
+ */
+void PROFILER::record(const char* name, int detail, int64_t start, int64_t end)
+{
+  Ring& ring = threadRing();
+  const uint64_t index = ring.head.load(std::memory_order_relaxed);
+  Slot& slot = ring.slots[index % RING_SIZE];
+
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.detail.store(detail, std::memory_order_relaxed);
+  slot.start.store(start, std::memory_order_relaxed);
+  slot.end.store(end, std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+  ring.head.store(index + 1, std::memory_order_release);
+}
+
+/**
+ *   @brief   The median and 99th percentile time of a zone
+ *   @details Over every time the zone is still in the rings.
+ *   @param   name The zone's name, e.g. "step".
+ */
+PROFILER::Latency PROFILER::latency(const char* name)
+{
+  std::vector<Event> events = collect(name);
+  std::vector<int64_t> times(events.size());
+  std::transform(events.begin(),
+                 events.end(),
+                 times.begin(),
+                 [](const Event& event) { return event.end - event.start; });
+
+  Latency latency;
+  latency.count = static_cast<int>(times.size());
+  if (times.empty())
+  {
+    return latency;
+  }
+
+  auto percentile = [&times](size_t percent) {
+    auto at = times.begin() + static_cast<std::ptrdiff_t>(
+                                (times.size() - 1) * percent / 100);
+    std::nth_element(times.begin(), at, times.end());
+    return static_cast<double>(*at) / 1e6;
+  };
+  latency.p50_ms = percentile(50);
+  latency.p99_ms = percentile(99);
+  return latency;
+}
+
+/**
+ *   @brief   Every zone in the rings as Chrome trace JSON
+ *   @details Load it in chrome://tracing or ui.perfetto.dev. Each
+ *            thread's zones are shown on their own track.
+ */
+std::string PROFILER::chromeTrace()
+{
+  std::vector<Event> events = collect(nullptr);
+  std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+    return a.start < b.start;
+  });
+
+  std::string trace = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  char numbers[96];
+  for (size_t i = 0; i < events.size(); i++)
+  {
+    const Event& event = events[i];
+    trace += i == 0 ? "\n{\"name\":\"" : ",\n{\"name\":\"";
+    appendEscaped(&trace, event.name);
+    if (event.detail != -1)
+    {
+      trace += ' ';
+      trace += std::to_string(event.detail);
+    }
+    std::snprintf(numbers,
+                  sizeof(numbers),
+                  "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+                  "\"dur\":%.3f}",
+                  event.thread,
+                  static_cast<double>(event.start) / 1e3,
+                  static_cast<double>(event.end - event.start) / 1e3);
+    trace += numbers;
+  }
+  trace += "\n]}\n";
+  return trace;
+}
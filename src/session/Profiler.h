@@ -0,0 +1,74 @@
+//
+// Created by Zoe on 23/11/2019.
+//
+
+#ifndef PROJECT_PROFILER_H
+#define PROJECT_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ *  Times named zones of code, e.g. a frame's update or a command.
+ *  Each thread records into its own ring buffer, keeping its newest
+ *  RING_SIZE zones, without locks. Off by default, when a zone costs a
+ *  single load and branch. The buffers can be read at any time, as
+ *  Chrome trace JSON (chrome://tracing) or as latency percentiles.
+ */
+namespace PROFILER
+{
+static const int RING_SIZE = 1 << 14;
+
+struct Latency
+{
+  int count = 0;
+  double p50_ms = 0;
+  double p99_ms = 0;
+};
+
+extern std::atomic<bool> active;
+
+inline bool enabled()
+{
+  return active.load(std::memory_order_relaxed);
+}
+
+void enable(bool on);
+int64_t now();
+void record(const char* name, int detail, int64_t start, int64_t end);
+Latency latency(const char* name);
+std::string chromeTrace();
+
+/**
+ *  Records the time from its construction to the end of its scope.
+ *  The name must outlive the profiler, e.g. a string literal. The
+ *  detail, if not -1, is added to the name in traces, e.g. an action.
+ */
+class Zone
+{
+ public:
+  explicit Zone(const char* zone_name, int zone_detail = -1) :
+    name(zone_name), detail(zone_detail), start(enabled() ? now() : -1)
+  {
+  }
+
+  ~Zone()
+  {
+    if (start != -1)
+    {
+      record(name, detail, start, now());
+    }
+  }
+
+  Zone(const Zone&) = delete;
+  Zone& operator=(const Zone&) = delete;
+
+ private:
+  const char* name;
+  int detail;
+  int64_t start;
+};
+}
+
+#endif // PROJECT_PROFILER_H
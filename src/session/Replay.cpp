@@ -0,0 +1,192 @@
+//
+// Created by Zoe on 15/11/2019.
+//
+
+#include "Replay.h"
+#include "GameSession.h"
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+const char* const SEED_PREFIX = "SEED ";
+const char* const SAVE_PREFIX = " SAVE ";
+const char* const HEX_DIGITS = "0123456789ABCDEF";
+
+int hexValue(char digit)
+{
+  const char* found = std::strchr(HEX_DIGITS, digit);
+  if (digit == '\0' || found == nullptr)
+  {
+    return -1;
+  }
+  return static_cast<int>(found - HEX_DIGITS);
+}
+
+/**
+ *   @brief   Reads the save written after the seed
+ *   @return  False if it isn't whole bytes of upper case hex.
+ */
+bool readSave(const char* hex, std::vector<char>* save)
+{
+  const size_t length = std::strlen(hex);
+  if (length % 2 != 0)
+  {
+    return false;
+  }
+
+  save->resize(length / 2);
+  for (size_t i = 0; i < save->size(); i++)
+  {
+    int high = hexValue(hex[i * 2]);
+    int low = hexValue(hex[i * 2 + 1]);
+    if (high == -1 || low == -1)
+    {
+      return false;
+    }
+    (*save)[i] = static_cast<char>(high * 16 + low);
+  }
+  return true;
+}
+}
+
+/**
+ *   @brief   A seed that restarts an engine from where it is now
+ */
+uint32_t REPLAY::engineSeed(const std::minstd_rand& engine)
+{
+  std::ostringstream state;
+  state << engine;
+  return static_cast<uint32_t>(std::stoul(state.str()));
+}
+
+/**
+ *   @brief   Writes a log as text
+ */
+std::string REPLAY::format(const Log& log)
+{
+  std::string text = SEED_PREFIX + std::to_string(log.seed);
+  if (!log.save.empty())
+  {
+    text += SAVE_PREFIX;
+    for (char byte : log.save)
+    {
+      text += HEX_DIGITS[static_cast<unsigned char>(byte) / 16];
+      text += HEX_DIGITS[static_cast<unsigned char>(byte) % 16];
+    }
+  }
+  text += '\n';
+  for (const auto& command : log.commands)
+  {
+    text += command;
+    text += '\n';
+  }
+  return text;
+}
+
+/**
+ *   @brief   Reads a log written by format()
+ *   @param   text The log's text.
+ *   @param   length The length of the text.
+ *   @param   log Set to the log that was read.
+ *   @return  False if the text doesn't start with a seed, or its save
+ *            isn't valid hex.
+ */
+bool REPLAY::parse(const char* text, size_t length, Log* log)
+{
+  const size_t prefix_length = std::strlen(SEED_PREFIX);
+  if (length < prefix_length ||
+      std::strncmp(text, SEED_PREFIX, prefix_length) != 0)
+  {
+    return false;
+  }
+
+  const char* end = text + length;
+  const char* line = text;
+  log->save.clear();
+  log->commands.clear();
+  while (line < end)
+  {
+    const char* line_end =
+      static_cast<const char*>(std::memchr(line, '\n', end - line));
+    if (line_end == nullptr)
+    {
+      line_end = end;
+    }
+
+    std::string value(line, line_end);
+    if (!value.empty() && value.back() == '\r')
+    {
+      value.pop_back();
+    }
+
+    if (line == text)
+    {
+      char* seed_end = nullptr;
+      log->seed = static_cast<uint32_t>(
+        std::strtoul(value.c_str() + prefix_length, &seed_end, 10));
+
+      const size_t save_length = std::strlen(SAVE_PREFIX);
+      if (std::strncmp(seed_end, SAVE_PREFIX, save_length) == 0 &&
+          !readSave(seed_end + save_length, &log->save))
+      {
+        return false;
+      }
+    }
+    else
+    {
+      log->commands.push_back(value);
+    }
+    line = line_end + 1;
+  }
+  return true;
+}
+
+/**
+ *   @brief   Puts a session where a log's game started
+ *   @details A new game from the log's seed, or the log's save.
+ *   @param   session A session that has loaded the world.
+ *   @param   log The game to play.
+ *   @return  False if the save isn't valid in the session's world.
+ */
+bool REPLAY::start(GameSession* session, const Log& log)
+{
+  session->seed(log.seed);
+  session->reset();
+  return log.save.empty() ||
+         session->loadGame(log.save.data(), log.save.size());
+}
+
+/**
+ *   @brief   Plays a log back and records everything the game said
+ *   @details Each command is written after a "> " followed by the
+ *            response, after the response to starting the game.
+ *   @param   prototype A session that has loaded the world, it is
+ *            copied and not changed.
+ *   @param   log The game to play.
+ *   @param   text Set to the transcript.
+ *   @return  False if the log's save couldn't be loaded.
+ */
+bool REPLAY::transcript(const GameSession& prototype,
+                        const Log& log,
+                        std::string* text)
+{
+  GameSession session = prototype;
+  if (!start(&session, log))
+  {
+    return false;
+  }
+
+  *text = session.response();
+  *text += '\n';
+  for (const auto& command : log.commands)
+  {
+    *text += "> ";
+    *text += command;
+    *text += '\n';
+    *text += session.step(command);
+    *text += '\n';
+  }
+  return true;
+}
@@ -0,0 +1,42 @@
+//
+// Created by Zoe on 15/11/2019.
+//
+
+#ifndef PROJECT_REPLAY_H
+#define PROJECT_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+class GameSession;
+
+/**
+ *  Recording games and playing them back exactly.
+ *  A log is the seed the game started with, the save it was loaded
+ *  from if it didn't start new, and every command typed, written as
+ *  text: a "SEED" line, with " SAVE" and the save in hex if there is
+ *  one, then one command per line. Playing a log back in the same
+ *  world always gives the same transcript.
+ */
+namespace REPLAY
+{
+struct Log
+{
+  uint32_t seed = 0;
+  std::vector<char> save; /**< Empty if the game started new. */
+  std::vector<std::string> commands;
+};
+
+uint32_t engineSeed(const std::minstd_rand& engine);
+std::string format(const Log& log);
+bool parse(const char* text, size_t length, Log* log);
+bool start(GameSession* session, const Log& log);
+bool transcript(const GameSession& prototype,
+                const Log& log,
+                std::string* text);
+}
+
+#endif // PROJECT_REPLAY_H
@@ -0,0 +1,313 @@
+//
+// Created by Zoe on 16/11/2019.
+//
+
+#include "SaveGame.h"
+#include "../map/WorldData.h"
+#include "../map/WorldImage.h"
+#include "Replay.h"
+#include "SessionState.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+/**
+ *   @brief   Adds whole numbers to the save, least significant byte
+ *            first whatever the machine's byte order
+ */
+template<typename Value>
+void addValues(std::vector<char>* save, const Value* values, size_t count)
+{
+  using Bits = typename std::make_unsigned<Value>::type;
+  for (size_t i = 0; i < count; i++)
+  {
+    const auto bits = static_cast<Bits>(values[i]);
+    for (size_t byte = 0; byte < sizeof(Value); byte++)
+    {
+      save->push_back(static_cast<char>((bits >> (byte * 8)) & 0xFF));
+    }
+  }
+}
+
+void addHeader(std::vector<char>* save, const SAVE::Header& header)
+{
+  const uint32_t fields[] = { header.magic,
+                              header.version,
+                              header.checksum,
+                              header.size,
+                              header.room_count,
+                              header.object_count,
+                              header.room_object_count,
+                              header.inventory_count,
+                              header.response_length };
+  addValues(save, fields, sizeof(fields) / sizeof(fields[0]));
+}
+
+/**
+ *  Reads the save in order, failing once any table runs past the end
+ *  of the save.
+ */
+class Reader
+{
+ public:
+  Reader(const char* bytes, size_t length) :
+    position(bytes), end(bytes + length)
+  {
+  }
+
+  /**
+   *   @brief   Reads whole numbers written by addValues()
+   */
+  template<typename Value>
+  bool read(Value* values, size_t count)
+  {
+    using Bits = typename std::make_unsigned<Value>::type;
+    if (static_cast<size_t>(end - position) / sizeof(Value) < count)
+    {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+      Bits bits = 0;
+      for (size_t byte = 0; byte < sizeof(Value); byte++)
+      {
+        bits = static_cast<Bits>(
+          bits | static_cast<Bits>(static_cast<uint8_t>(*position++))
+                   << (byte * 8));
+      }
+      values[i] = static_cast<Value>(bits);
+    }
+    return true;
+  }
+
+  bool readHeader(SAVE::Header* header)
+  {
+    return read(&header->magic, 1) && read(&header->version, 1) &&
+           read(&header->checksum, 1) && read(&header->size, 1) &&
+           read(&header->room_count, 1) && read(&header->object_count, 1) &&
+           read(&header->room_object_count, 1) &&
+           read(&header->inventory_count, 1) &&
+           read(&header->response_length, 1);
+  }
+
+  bool readPlayer(SAVE::PlayerRecord* player)
+  {
+    return read(&player->current_room, 1) &&
+           read(&player->light_amount, 1) && read(&player->score, 1) &&
+           read(&player->random_state, 1) && read(&player->flags, 1);
+  }
+
+  bool finished() const { return position == end; }
+
+ private:
+  const char* position;
+  const char* end;
+};
+
+bool validLocation(int32_t location, int room_count)
+{
+  return location == DATA::CARRIED || location == DATA::NOWHERE ||
+         (location >= 0 && location < room_count);
+}
+}
+
+/**
+ *   @brief   Saves a game in progress
+ *   @param   state The session's state.
+ *   @param   response The last thing the game said, shown again when
+ *            the game is loaded.
+ *   @return  The save bytes, ready for read().
+ */
+std::vector<char> SAVE::write(const SessionState& state,
+                              const std::string& response)
+{
+  const size_t room_count = state.exits.size();
+  const size_t object_count = state.object_location.size();
+
+  Header header = {};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.room_count = static_cast<uint32_t>(room_count);
+  header.object_count = static_cast<uint32_t>(object_count);
+  header.inventory_count = static_cast<uint32_t>(state.inventory.count);
+  header.response_length = static_cast<uint32_t>(response.size());
+
+  PlayerRecord player = {};
+  player.current_room = state.current_room;
+  player.light_amount = state.light_amount;
+  player.score = state.score;
+  player.random_state = REPLAY::engineSeed(state.random_engine);
+  player.flags = (state.light_ignited ? FLAG_LIGHT_IGNITED : 0) |
+                 (state.axed_tree ? FLAG_AXED_TREE : 0) |
+                 (state.up_tree ? FLAG_UP_TREE : 0) |
+                 (state.in_end_state ? FLAG_IN_END_STATE : 0) |
+                 (state.game_over ? FLAG_GAME_OVER : 0);
+
+  // only the order of each room's objects is kept, the links are rebuilt
+  std::vector<int32_t> room_objects;
+  for (size_t room = 0; room < room_count; room++)
+  {
+    for (int32_t object = state.room_first[room]; object != -1;
+         object = state.object_next[static_cast<size_t>(object)])
+    {
+      room_objects.push_back(object);
+    }
+  }
+  header.room_object_count = static_cast<uint32_t>(room_objects.size());
+
+  std::vector<char> save(sizeof(Header));
+  save.reserve(sizeof(Header) + sizeof(PlayerRecord) + object_count * 13 +
+               room_count * 2 + response.size());
+  addValues(&save, &player.current_room, 1);
+  addValues(&save, &player.light_amount, 1);
+  addValues(&save, &player.score, 1);
+  addValues(&save, &player.random_state, 1);
+  addValues(&save, &player.flags, 1);
+  addValues(&save, state.object_location.data(), object_count);
+  addValues(&save, room_objects.data(), room_objects.size());
+  addValues(&save, state.inventory.objects.data(), header.inventory_count);
+  addValues(&save, state.exits.data(), room_count);
+  addValues(&save, state.hidden_objects.data(), object_count);
+  addValues(&save, response.data(), response.size());
+
+  header.size = static_cast<uint32_t>(save.size());
+  header.checksum =
+    IMAGE::checksum(save.data() + sizeof(Header), save.size() - sizeof(Header));
+  std::vector<char> header_bytes;
+  addHeader(&header_bytes, header);
+  std::copy(header_bytes.begin(), header_bytes.end(), save.begin());
+  return save;
+}
+
+/**
+ *   @brief   Loads a game saved by write()
+ *   @details The save is rejected if it is from another version, is
+ *            damaged or was saved in a world of another size. Nothing
+ *            is changed unless the whole save is valid.
+ *   @param   bytes The save bytes.
+ *   @param   length The size of the save in bytes.
+ *   @param   world_data The world the game was saved in.
+ *   @param   state Set to the saved state.
+ *   @param   response Set to the last thing the game said.
+ *   @return  True if the save was valid and loaded.
+ */
+bool SAVE::read(const char* bytes,
+                size_t length,
+                const WorldData& world_data,
+                SessionState* state,
+                std::string* response)
+{
+  Header header = {};
+  Reader reader(bytes, length);
+  if (!reader.readHeader(&header))
+  {
+    return false;
+  }
+
+  const int room_count = world_data.roomCount();
+  const int object_count = world_data.objectCount();
+  if (header.magic != MAGIC || header.version != VERSION ||
+      header.size != length ||
+      header.checksum != IMAGE::checksum(bytes + sizeof(header),
+                                         length - sizeof(header)) ||
+      header.room_count != static_cast<uint32_t>(room_count) ||
+      header.object_count != static_cast<uint32_t>(object_count) ||
+      header.room_object_count > header.object_count ||
+      header.inventory_count > header.object_count ||
+      header.response_length > length)
+  {
+    return false;
+  }
+
+  PlayerRecord player = {};
+  SessionState loaded = world_data.startingState();
+  std::vector<int32_t> room_objects(header.room_object_count);
+  std::vector<int32_t> inventory(header.inventory_count);
+  std::string text(header.response_length, ' ');
+
+  if (!reader.readPlayer(&player) ||
+      !reader.read(loaded.object_location.data(), header.object_count) ||
+      !reader.read(room_objects.data(), room_objects.size()) ||
+      !reader.read(inventory.data(), inventory.size()) ||
+      !reader.read(loaded.exits.data(), header.room_count) ||
+      !reader.read(loaded.hidden_objects.data(), header.object_count) ||
+      !reader.read(&text[0], text.size()) || !reader.finished() ||
+      player.current_room < 0 || player.current_room >= room_count)
+  {
+    return false;
+  }
+
+  // every object in a room or carried must be listed exactly once
+  uint32_t in_rooms = 0;
+  uint32_t carried = 0;
+  for (int32_t location : loaded.object_location)
+  {
+    if (!validLocation(location, room_count))
+    {
+      return false;
+    }
+    in_rooms += location >= 0 ? 1 : 0;
+    carried += location == DATA::CARRIED ? 1 : 0;
+  }
+  if (in_rooms != header.room_object_count ||
+      carried != header.inventory_count)
+  {
+    return false;
+  }
+
+  std::fill(loaded.room_first.begin(), loaded.room_first.end(), -1);
+  std::fill(loaded.room_last.begin(), loaded.room_last.end(), -1);
+  std::fill(loaded.object_next.begin(), loaded.object_next.end(), -1);
+  std::fill(loaded.object_prev.begin(), loaded.object_prev.end(), -1);
+  for (int32_t object : room_objects)
+  {
+    if (object < 0 || object >= object_count)
+    {
+      return false;
+    }
+    const int32_t room = loaded.object_location[object];
+    if (room < 0 || loaded.object_prev[object] != -1 ||
+        loaded.room_first[room] == object)
+    {
+      return false;
+    }
+
+    const int32_t last = loaded.room_last[room];
+    loaded.object_prev[object] = last;
+    if (last == -1)
+    {
+      loaded.room_first[room] = object;
+    }
+    else
+    {
+      loaded.object_next[last] = object;
+    }
+    loaded.room_last[room] = object;
+  }
+
+  for (int32_t object : inventory)
+  {
+    if (object < 0 || object >= object_count ||
+        loaded.object_location[object] != DATA::CARRIED ||
+        loaded.inventory.has(object))
+    {
+      return false;
+    }
+    loaded.inventory.add(object, world_data.object(object).treasure());
+  }
+
+  loaded.current_room = player.current_room;
+  loaded.light_amount = player.light_amount;
+  loaded.score = player.score;
+  loaded.light_ignited = (player.flags & FLAG_LIGHT_IGNITED) != 0;
+  loaded.axed_tree = (player.flags & FLAG_AXED_TREE) != 0;
+  loaded.up_tree = (player.flags & FLAG_UP_TREE) != 0;
+  loaded.in_end_state = (player.flags & FLAG_IN_END_STATE) != 0;
+  loaded.game_over = (player.flags & FLAG_GAME_OVER) != 0;
+  loaded.random_engine.seed(player.random_state);
+
+  *state = std::move(loaded);
+  *response = std::move(text);
+  return true;
+}
@@ -0,0 +1,72 @@
+//
+// Created by Zoe on 16/11/2019.
+//
+
+#ifndef PROJECT_SAVEGAME_H
+#define PROJECT_SAVEGAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class WorldData;
+struct SessionState;
+
+/**
+ *  The saved game.
+ *  A little-endian blob made of a header, the player, where each object
+ *  is, the objects in each room in order, the inventory in order, the
+ *  exits of every room, which objects are still hidden and the last
+ *  response.
+ *  Everything else in a SessionState is rebuilt from these when the
+ *  game is loaded. The checksum covers everything after the header.
+ *  Every value is written a byte at a time, so a save moves between
+ *  machines, e.g. in a session log.
+ */
+namespace SAVE
+{
+const uint32_t MAGIC = 0x56534248; /**< "HBSV" */
+const uint32_t VERSION = 1;
+
+struct Header
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t checksum;
+  uint32_t size; /**< Size of the whole save in bytes. */
+
+  uint32_t room_count;
+  uint32_t object_count;
+  uint32_t room_object_count; /**< Objects lying in a room. */
+  uint32_t inventory_count;
+  uint32_t response_length;
+};
+
+struct PlayerRecord
+{
+  int32_t current_room;
+  int32_t light_amount;
+  int32_t score;
+  uint32_t random_state;
+  uint32_t flags; /**< See the FLAG_ values. */
+};
+
+static_assert(sizeof(Header) == 36, "save header layout changed");
+static_assert(sizeof(PlayerRecord) == 20, "save player layout changed");
+
+const uint32_t FLAG_LIGHT_IGNITED = 1;
+const uint32_t FLAG_AXED_TREE = 2;
+const uint32_t FLAG_UP_TREE = 4;
+const uint32_t FLAG_IN_END_STATE = 8;
+const uint32_t FLAG_GAME_OVER = 16;
+
+std::vector<char> write(const SessionState& state, const std::string& response);
+bool read(const char* bytes,
+          size_t length,
+          const WorldData& world_data,
+          SessionState* state,
+          std::string* response);
+}
+
+#endif // PROJECT_SAVEGAME_H
@@ -0,0 +1,260 @@
+//
+// Created by Zoe on 05/11/2019.
+//
+
+#include "SessionHost.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+
+namespace
+{
+// commands a worker runs for one session before letting others in
+const int COMMAND_BATCH = 32;
+
+unsigned int workerCount(unsigned int requested)
+{
+  if (requested != 0)
+  {
+    return requested;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+}
+
+SessionHost::SessionHost(DATA::FileReader reader, unsigned int num_workers) :
+  prototype(std::move(reader)), pool(workerCount(num_workers))
+{
+  counters.reset(new WorkerCounter[pool.size()]);
+}
+
+/**
+ *   @brief   Destructor.
+ *   @details Lets every queued command finish before the sessions
+ *            are released.
+ */
+SessionHost::~SessionHost()
+{
+  wait();
+}
+
+/**
+ *   @brief   Loads the game data used by every hosted session
+ *   @details The data is loaded once into a prototype session and new
+ *            sessions are copied from it, so creating a session does
+ *            not touch the disk.
+ *   @return  True if the data loaded.
+ */
+bool SessionHost::load()
+{
+  bool loaded = prototype.load();
+  prototype.reset();
+  return loaded;
+}
+
+/**
+ *   @brief   Moves every session on to a new version of the world
+ *   @details Each session switches between two of its commands, on
+ *            the worker pool, so sessions carry on playing while they
+ *            are moved. A session only switches once if it is sent
+ *            several worlds before it runs. New sessions start in the
+ *            new world.
+ *   @param   world_data The new world, e.g. from a WorldWatcher.
+ */
+void SessionHost::reloadWorld(std::shared_ptr<const WorldData> world_data)
+{
+  std::lock_guard<std::mutex> sessions_lock(sessions_mutex);
+  prototype.reload(world_data);
+  prototype.reset();
+
+  for (auto& hosted_session : sessions)
+  {
+    bool needs_scheduling = false;
+    {
+      std::lock_guard<std::mutex> lock(hosted_session->mutex);
+      if (!hosted_session->next_world)
+      {
+        std::lock_guard<std::mutex> pending_lock(pending_mutex);
+        pending += 1;
+      }
+      hosted_session->next_world = world_data;
+      if (!hosted_session->scheduled)
+      {
+        hosted_session->scheduled = true;
+        needs_scheduling = true;
+      }
+    }
+
+    if (needs_scheduling)
+    {
+      schedule(hosted_session.get());
+    }
+  }
+}
+
+/**
+ *   @brief   Sets a function called with every response
+ *   @details The handler is called from the worker threads, but never
+ *            concurrently for the same session.
+ */
+void SessionHost::onResponse(ResponseHandler handler)
+{
+  response_handler = std::move(handler);
+}
+
+int SessionHost::createSession()
+{
+  std::lock_guard<std::mutex> lock(sessions_mutex);
+  std::unique_ptr<HostedSession> hosted_session(new HostedSession(prototype));
+  hosted_session->game.seed(std::random_device{}());
+
+  hosted_session->id = static_cast<int>(sessions.size());
+  sessions.push_back(std::move(hosted_session));
+  return sessions.back()->id;
+}
+
+/**
+ *   @brief   Queues a command for a session
+ *   @details The command is run on the worker pool. Call wait() to
+ *            block until every queued command has been run.
+ *   @param   session The session ID returned by createSession().
+ *   @param   command The command, e.g. "GET ROPE".
+ */
+void SessionHost::submit(int session, const std::string& command)
+{
+  HostedSession& hosted_session = hosted(session);
+
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    pending += 1;
+  }
+
+  bool needs_scheduling = false;
+  {
+    std::lock_guard<std::mutex> lock(hosted_session.mutex);
+    hosted_session.commands.push_back(command);
+    if (!hosted_session.scheduled)
+    {
+      hosted_session.scheduled = true;
+      needs_scheduling = true;
+    }
+  }
+
+  if (needs_scheduling)
+  {
+    schedule(&hosted_session);
+  }
+}
+
+void SessionHost::wait()
+{
+  std::unique_lock<std::mutex> lock(pending_mutex);
+  idle.wait(lock, [this] { return pending == 0; });
+}
+
+int SessionHost::sessionCount()
+{
+  std::lock_guard<std::mutex> lock(sessions_mutex);
+  return static_cast<int>(sessions.size());
+}
+
+/**
+ *   @brief   Gives access to a hosted session
+ *   @details Only safe once wait() has returned, as the session may
+ *            otherwise be running on a worker.
+ */
+GameSession& SessionHost::session(int session)
+{
+  return hosted(session).game;
+}
+
+std::vector<SessionHost::WorkerStats> SessionHost::workerStats()
+{
+  auto pool_stats = pool.stats();
+  std::vector<WorkerStats> result(pool_stats.size());
+  for (size_t i = 0; i < pool_stats.size(); i++)
+  {
+    result[i].commands = counters[i].commands;
+    result[i].tasks = pool_stats[i].tasks;
+    result[i].steals = pool_stats[i].steals;
+    result[i].busy_seconds = pool_stats[i].busy_seconds;
+    if (result[i].busy_seconds > 0)
+    {
+      result[i].commands_per_second =
+        static_cast<double>(result[i].commands) / result[i].busy_seconds;
+    }
+  }
+  return result;
+}
+
+SessionHost::HostedSession& SessionHost::hosted(int session)
+{
+  std::lock_guard<std::mutex> lock(sessions_mutex);
+  return *sessions.at(static_cast<size_t>(session));
+}
+
+void SessionHost::schedule(HostedSession* hosted_session)
+{
+  pool.submit([this, hosted_session] { runSession(hosted_session); });
+}
+
+void SessionHost::runSession(HostedSession* hosted_session)
+{
+  uint64_t processed = 0;
+  std::shared_ptr<const WorldData> next_world;
+  {
+    std::lock_guard<std::mutex> lock(hosted_session->mutex);
+    next_world.swap(hosted_session->next_world);
+  }
+  if (next_world)
+  {
+    hosted_session->game.reload(std::move(next_world));
+    processed += 1;
+  }
+
+  uint64_t commands_run = 0;
+  for (int i = 0; i < COMMAND_BATCH; i++)
+  {
+    std::string command;
+    {
+      std::lock_guard<std::mutex> lock(hosted_session->mutex);
+      if (hosted_session->commands.empty())
+      {
+        break;
+      }
+      command = std::move(hosted_session->commands.front());
+      hosted_session->commands.pop_front();
+    }
+
+    const std::string& response = hosted_session->game.step(command);
+    if (response_handler)
+    {
+      response_handler(hosted_session->id, command, response);
+    }
+    commands_run += 1;
+  }
+  processed += commands_run;
+
+  counters[static_cast<size_t>(WorkerPool::currentWorker())].commands +=
+    commands_run;
+
+  bool more_commands = false;
+  {
+    std::lock_guard<std::mutex> lock(hosted_session->mutex);
+    more_commands =
+      !hosted_session->commands.empty() || hosted_session->next_world;
+    hosted_session->scheduled = more_commands;
+  }
+
+  if (more_commands)
+  {
+    schedule(hosted_session);
+  }
+
+  std::lock_guard<std::mutex> lock(pending_mutex);
+  pending -= processed;
+  if (pending == 0)
+  {
+    idle.notify_all();
+  }
+}
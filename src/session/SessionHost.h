@@ -0,0 +1,99 @@
+//
+// Created by Zoe on 05/11/2019.
+//
+
+#ifndef PROJECT_SESSIONHOST_H
+#define PROJECT_SESSIONHOST_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "DataReader.h"
+#include "GameSession.h"
+#include "WorkerPool.h"
+
+/**
+ *  Hosts many independent game sessions in one process.
+ *  Commands are queued per session and run on a work-stealing worker
+ *  pool. A session is only ever run by one worker at a time and its
+ *  commands are applied in the order they were submitted.
+ */
+class SessionHost
+{
+ public:
+  using ResponseHandler = std::function<void(
+    int session, const std::string& command, const std::string& response)>;
+
+  struct WorkerStats
+  {
+    uint64_t commands = 0; /**< Commands run by the worker. */
+    uint64_t tasks = 0;    /**< Session batches run by the worker. */
+    uint64_t steals = 0;   /**< Batches taken from another worker. */
+    double busy_seconds = 0;
+    double commands_per_second = 0;
+  };
+
+  explicit SessionHost(DATA::FileReader reader, unsigned int num_workers = 0);
+  ~SessionHost();
+
+  SessionHost(const SessionHost&) = delete;
+  SessionHost& operator=(const SessionHost&) = delete;
+
+  bool load();
+  void reloadWorld(std::shared_ptr<const WorldData> world_data);
+  void onResponse(ResponseHandler handler);
+
+  int createSession();
+  void submit(int session, const std::string& command);
+  void wait();
+
+  int sessionCount();
+  GameSession& session(int session);
+  std::vector<WorkerStats> workerStats();
+
+ private:
+  struct HostedSession
+  {
+    explicit HostedSession(const GameSession& prototype) : game(prototype) {}
+
+    int id = 0;
+    GameSession game;
+
+    std::mutex mutex;
+    std::deque<std::string> commands;
+    std::shared_ptr<const WorldData> next_world; /**< Reload, if any. */
+    bool scheduled = false;
+  };
+
+  struct WorkerCounter
+  {
+    std::atomic<uint64_t> commands{ 0 };
+    char padding[64 - sizeof(std::atomic<uint64_t>)]; /**< Own cache line. */
+  };
+
+  HostedSession& hosted(int session);
+  void schedule(HostedSession* hosted_session);
+  void runSession(HostedSession* hosted_session);
+
+  GameSession prototype;
+  ResponseHandler response_handler;
+
+  std::mutex sessions_mutex;
+  std::vector<std::unique_ptr<HostedSession>> sessions;
+
+  std::mutex pending_mutex;
+  std::condition_variable idle;
+  uint64_t pending = 0;
+
+  std::unique_ptr<WorkerCounter[]> counters;
+  WorkerPool pool;
+};
+
+#endif // PROJECT_SESSIONHOST_H
@@ -0,0 +1,51 @@
+//
+// Created by Zoe on 06/11/2019.
+//
+
+#ifndef PROJECT_SESSIONSTATE_H
+#define PROJECT_SESSIONSTATE_H
+
+#include "../game/GameConstants.h"
+#include "Inventory.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ *  Everything that changes during a single play-through.
+ *  Names, descriptions and responses live in the shared WorldData,
+ *  so this is all a session needs to keep for itself. The tables are
+ *  sized by WorldData when the world loads.
+ */
+struct SessionState
+{
+  std::vector<uint16_t> exits;         /**< Bit per direction, per room. */
+  std::vector<uint8_t> hidden_objects; /**< Per object, 1 if hidden. */
+
+  /** Where each object is, a room index, CARRIED or NOWHERE. */
+  std::vector<int32_t> object_location;
+
+  /** Objects in each room as a list, linked by object index, -1 ends. */
+  std::vector<int32_t> room_first;
+  std::vector<int32_t> room_last;
+  std::vector<int32_t> object_next;
+  std::vector<int32_t> object_prev;
+
+  Inventory inventory;
+
+  int current_room = 0;
+  int light_amount = 0;
+  int score = 0;
+
+  bool light_ignited = false;
+  bool axed_tree = false;
+  bool up_tree = false;
+  bool in_end_state = false;
+  bool game_over = false;
+
+  uint32_t revision = 0; /**< Bumped by every change to the world. */
+
+  std::minstd_rand random_engine;
+};
+
+#endif // PROJECT_SESSIONSTATE_H
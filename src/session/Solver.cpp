@@ -0,0 +1,480 @@
+//
+// Created by Zoe on 14/11/2019.
+//
+
+#include "Solver.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+/** Frontier chunks per worker, so a slow chunk doesn't hold up a depth. */
+const unsigned int CHUNKS_PER_WORKER = 4;
+
+struct Candidate
+{
+  uint64_t key;
+  int parent;
+  int command;
+  int progress;
+  bool won;
+  bool accepted;
+  SessionState state;
+};
+
+/** A command that changed a state, by the state's ID and the key after. */
+struct Edge
+{
+  uint64_t from;
+  uint64_t to;
+};
+
+struct Chunk
+{
+  std::vector<Candidate> candidates;
+  std::vector<Edge> edges;      /**< From the state's frontier index. */
+  std::vector<uint8_t> carried; /**< Per object, 1 if ever carried. */
+  uint64_t commands_run = 0;
+};
+
+uint64_t mix(uint64_t hash, uint64_t value)
+{
+  hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+/**
+ *   @brief   Reduces a state to a key
+ *   @details Covers everything the rules look at, including the
+ *            random engine the magic word teleports with. The revision,
+ *            the order of the inventory and the order of each room's
+ *            objects are left out, so the same state reached by two
+ *            paths is only explored once.
+ */
+uint64_t stateKey(const SessionState& state)
+{
+  uint64_t hash = 14695981039346656037ull;
+  hash = mix(hash, static_cast<uint64_t>(state.current_room));
+  hash = mix(hash, static_cast<uint64_t>(state.light_amount));
+  hash = mix(hash,
+             (state.light_ignited ? 1u : 0u) | (state.axed_tree ? 2u : 0u) |
+               (state.up_tree ? 4u : 0u) | (state.in_end_state ? 8u : 0u) |
+               (state.game_over ? 16u : 0u));
+  for (uint16_t exits : state.exits)
+  {
+    hash = mix(hash, exits);
+  }
+  for (uint8_t hidden : state.hidden_objects)
+  {
+    hash = mix(hash, hidden);
+  }
+  for (int32_t location : state.object_location)
+  {
+    hash = mix(hash, static_cast<uint32_t>(location));
+  }
+
+  // the engine's next number stands in for its state, which it can't
+  // give without a stream, as each state has a different next number
+  std::minstd_rand engine = state.random_engine;
+  hash = mix(hash, engine());
+  return hash;
+}
+
+/**
+ *   @brief   How far a state has got towards winning
+ *   @details Used to choose the states kept when the frontier is
+ *            limited.
+ */
+int progress(const SessionState& state)
+{
+  int score = state.inventory.points * 4 + (state.in_end_state ? 1000 : 0);
+  for (uint8_t hidden : state.hidden_objects)
+  {
+    score += hidden != 0 ? 0 : 1;
+  }
+  for (uint16_t exits : state.exits)
+  {
+    for (int i = 0; i < DATA::DIRECTION_NUM; i++)
+    {
+      score += (exits >> i) & 1;
+    }
+  }
+  return score;
+}
+
+/**
+ *   @brief   Which explored states the game may still be won from
+ *   @details A reverse pass over every command that changed a state. A
+ *            state may be won from if it was never expanded, or a
+ *            command leads from it to a won state, a state that was
+ *            never kept, or a state that may be won from. Won states
+ *            are never kept. Everything else only leads to states the
+ *            game can't be won from.
+ *   @param   state_count The states kept, by ID.
+ *   @param   expanded The states with IDs below this were expanded.
+ *   @param   edges Every command that changed a state, by key.
+ *   @param   ids The ID of each state kept, by key.
+ */
+std::vector<uint8_t>
+mayWin(size_t state_count,
+       size_t expanded,
+       const std::vector<Edge>& edges,
+       const std::unordered_map<uint64_t, uint64_t>& ids)
+{
+  std::vector<uint8_t> may_win(state_count, 0);
+  std::fill(may_win.begin() + static_cast<std::ptrdiff_t>(expanded),
+            may_win.end(),
+            1);
+
+  // the commands leading to each kept state, grouped by that state
+  std::vector<size_t> first(state_count + 1, 0);
+  std::vector<uint64_t> to_ids(edges.size(), state_count);
+  for (size_t i = 0; i < edges.size(); i++)
+  {
+    auto id = ids.find(edges[i].to);
+    if (id != ids.end())
+    {
+      to_ids[i] = id->second;
+      first[id->second + 1] += 1;
+    }
+    else
+    {
+      may_win[edges[i].from] = 1;
+    }
+  }
+  for (size_t i = 0; i < state_count; i++)
+  {
+    first[i + 1] += first[i];
+  }
+  std::vector<uint64_t> from_ids(first.back());
+  std::vector<size_t> filled(first.begin(), first.end() - 1);
+  for (size_t i = 0; i < edges.size(); i++)
+  {
+    if (to_ids[i] != state_count)
+    {
+      from_ids[filled[to_ids[i]]++] = edges[i].from;
+    }
+  }
+
+  std::vector<uint64_t> open;
+  for (size_t i = 0; i < state_count; i++)
+  {
+    if (may_win[i] != 0)
+    {
+      open.push_back(i);
+    }
+  }
+  while (!open.empty())
+  {
+    uint64_t to = open.back();
+    open.pop_back();
+    for (size_t i = first[to]; i < first[to + 1]; i++)
+    {
+      if (may_win[from_ids[i]] == 0)
+      {
+        may_win[from_ids[i]] = 1;
+        open.push_back(from_ids[i]);
+      }
+    }
+  }
+  return may_win;
+}
+}
+
+Solver::Solver(DATA::FileReader reader) : prototype(std::move(reader)) {}
+
+/**
+ *   @brief   Loads the world to solve
+ *   @return  True if the data loaded.
+ */
+bool Solver::load()
+{
+  bool loaded = prototype.load();
+  buildCommands();
+  return loaded;
+}
+
+/**
+ *   @brief   Every command the search tries in each state
+ *   @details Each verb on its own, and verbs that act on an object with
+ *            every object's name and the magic word. UNDO only goes
+ *            back to states already seen, so it isn't tried.
+ */
+const std::vector<std::string>& Solver::commands() const
+{
+  return command_list;
+}
+
+void Solver::buildCommands()
+{
+  const WorldData& world_data = prototype.worldData();
+  command_list.clear();
+
+  for (int i = 0; i < world_data.actionCount(); i++)
+  {
+    const std::string& verb = world_data.action(i).actionVerb();
+    if ((i > 0 && world_data.action(i - 1).actionVerb() == verb) ||
+        i == DATA::UNDO_ACTION)
+    {
+      continue;
+    }
+
+    if (world_data.precondition(i).object == -1)
+    {
+      command_list.push_back(verb);
+      continue;
+    }
+
+    for (int j = 0; j < world_data.objectCount(); j++)
+    {
+      command_list.push_back(verb + " " + world_data.object(j).objectName());
+    }
+    command_list.push_back(verb + " " + DATA::MAGIC_WORD);
+  }
+}
+
+/**
+ *   @brief   Searches for the shortest way to win
+ *   @details Runs until the game is won, every state has been seen or
+ *            the depth limit is reached. Then counts the dead ends:
+ *            states whose every command was tried, and every command
+ *            in the states those lead to, without reaching a win.
+ *            States cut from the frontier or left at the depth limit
+ *            are assumed to be winnable, so none are counted wrongly.
+ *   @param   options How to search, see Solver::Options.
+ *   @return  What the search found.
+ */
+Solver::Result Solver::solve(const Options& options)
+{
+  Result result;
+
+  unsigned int num_workers = options.num_workers;
+  if (num_workers == 0)
+  {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  WorkerPool pool(num_workers);
+
+  prototype.seed(options.seed);
+  prototype.reset();
+
+  const WorldData& world_data = prototype.worldData();
+  const auto object_count = static_cast<size_t>(world_data.objectCount());
+  std::vector<uint8_t> carried(object_count, 0);
+
+  std::vector<std::unordered_set<uint64_t>> visited(num_workers);
+  std::vector<std::vector<Node>> levels = { { { -1, -1 } } };
+  std::vector<SessionState> frontier = { prototype.snapshot() };
+
+  // every kept state has an ID, in depth then frontier order, so the
+  // dead ends can be found once the search is over
+  std::unordered_map<uint64_t, uint64_t> ids;
+  std::vector<Edge> edges;
+  uint64_t expanded = 0;
+
+  uint64_t root = stateKey(frontier[0]);
+  visited[root % num_workers].insert(root);
+  ids[root] = 0;
+  result.states = 1;
+
+  for (int depth = 0; depth < options.max_depth && !frontier.empty();
+       depth++)
+  {
+    result.depth = depth;
+
+    // expand every state in the frontier, only checking states seen at
+    // earlier depths so the workers don't share anything they write to
+    const auto chunk_count = static_cast<unsigned int>(std::min<size_t>(
+      frontier.size(), num_workers * CHUNKS_PER_WORKER));
+    const size_t chunk_size = (frontier.size() + chunk_count - 1) / chunk_count;
+    std::vector<Chunk> chunks(chunk_count);
+
+    pool.runAll(chunk_count, [&](unsigned int c) {
+      Chunk& chunk = chunks[c];
+      chunk.carried.assign(object_count, 0);
+      GameSession session = prototype;
+
+      size_t end = std::min(frontier.size(), (c + 1) * chunk_size);
+      for (size_t i = c * chunk_size; i < end; i++)
+      {
+        const uint64_t parent_key = stateKey(frontier[i]);
+        session.restore(frontier[i]);
+
+        for (size_t command = 0; command < command_list.size(); command++)
+        {
+          if (!session.accepts(command_list[command]))
+          {
+            continue;
+          }
+
+          session.step(command_list[command]);
+          chunk.commands_run += 1;
+
+          const SessionState& state = session.snapshot();
+          uint64_t key = stateKey(state);
+          if (key != parent_key)
+          {
+            chunk.edges.push_back({ i, key });
+            for (size_t j = 0; j < object_count; j++)
+            {
+              chunk.carried[j] |= state.inventory.carried[j];
+            }
+
+            if (visited[key % num_workers].count(key) == 0)
+            {
+              chunk.candidates.push_back({ key,
+                                           static_cast<int>(i),
+                                           static_cast<int>(command),
+                                           progress(state),
+                                           state.game_over,
+                                           false,
+                                           state });
+            }
+          }
+          session.restore(frontier[i]);
+        }
+      }
+    });
+
+    // each worker keeps the states new to its share of the keys, the
+    // first of each in frontier order so the result doesn't depend on
+    // the number of workers
+    pool.runAll(num_workers, [&](unsigned int shard) {
+      for (Chunk& chunk : chunks)
+      {
+        for (Candidate& candidate : chunk.candidates)
+        {
+          if (candidate.key % num_workers == shard)
+          {
+            candidate.accepted = visited[shard].insert(candidate.key).second;
+          }
+        }
+      }
+    });
+
+    std::vector<Candidate*> next;
+    for (Chunk& chunk : chunks)
+    {
+      result.commands_run += chunk.commands_run;
+      for (const Edge& edge : chunk.edges)
+      {
+        edges.push_back({ expanded + edge.from, edge.to });
+      }
+      for (size_t j = 0; j < object_count; j++)
+      {
+        carried[j] |= chunk.carried[j];
+      }
+      for (Candidate& candidate : chunk.candidates)
+      {
+        if (candidate.accepted)
+        {
+          next.push_back(&candidate);
+        }
+      }
+    }
+    result.states += next.size();
+    expanded += frontier.size();
+
+    auto won = std::find_if(
+      next.begin(), next.end(), [](const Candidate* c) { return c->won; });
+    if (won != next.end() && !result.completable)
+    {
+      result.completable = true;
+      result.solution = pathTo(levels, depth, (*won)->parent);
+      result.solution.push_back(command_list[(*won)->command]);
+    }
+    if (result.completable && options.stop_at_win)
+    {
+      result.depth = depth + 1;
+      break;
+    }
+
+    if (options.frontier_limit != 0 && next.size() > options.frontier_limit)
+    {
+      std::stable_sort(
+        next.begin(), next.end(), [](const Candidate* a, const Candidate* b) {
+          return a->progress > b->progress;
+        });
+      next.resize(options.frontier_limit);
+      result.exhaustive = false;
+    }
+
+    // won games end here, there's nothing left to do in them
+    std::vector<SessionState> next_frontier;
+    std::vector<Node> level;
+    for (Candidate* candidate : next)
+    {
+      if (!candidate->won)
+      {
+        ids[candidate->key] = expanded + next_frontier.size();
+        next_frontier.push_back(std::move(candidate->state));
+        level.push_back({ candidate->parent, candidate->command });
+      }
+    }
+    frontier.swap(next_frontier);
+    levels.push_back(std::move(level));
+    result.depth = depth + 1;
+  }
+
+  // states were left unexplored at the depth limit
+  if (!frontier.empty() && !(result.completable && options.stop_at_win))
+  {
+    result.exhaustive = false;
+  }
+
+  std::vector<uint8_t> may_win = mayWin(ids.size(), expanded, edges, ids);
+  uint64_t level_start = 0;
+  for (size_t depth = 0; depth < levels.size(); depth++)
+  {
+    for (size_t i = 0; i < levels[depth].size(); i++)
+    {
+      if (may_win[level_start + i] != 0)
+      {
+        continue;
+      }
+      if (result.dead_ends == 0)
+      {
+        result.dead_end_path =
+          pathTo(levels, static_cast<int>(depth), static_cast<int>(i));
+      }
+      result.dead_ends += 1;
+    }
+    level_start += levels[depth].size();
+  }
+
+  for (int i = 0; i < world_data.treasureCount(); i++)
+  {
+    int treasure = world_data.treasure(i);
+    if (carried[static_cast<size_t>(treasure)] == 0)
+    {
+      result.unreached_treasures.push_back(treasure);
+    }
+  }
+  return result;
+}
+
+/**
+ *   @brief   The commands that lead to a state
+ *   @param   levels The states kept at each depth.
+ *   @param   depth The state's depth.
+ *   @param   index The state's index at its depth.
+ */
+std::vector<std::string>
+Solver::pathTo(const std::vector<std::vector<Node>>& levels,
+               int depth,
+               int index) const
+{
+  std::vector<std::string> path;
+  for (int d = depth; d > 0; d--)
+  {
+    const Node& node =
+      levels[static_cast<size_t>(d)][static_cast<size_t>(index)];
+    path.push_back(command_list[static_cast<size_t>(node.command)]);
+    index = node.parent;
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
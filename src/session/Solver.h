@@ -0,0 +1,86 @@
+//
+// Created by Zoe on 14/11/2019.
+//
+
+#ifndef PROJECT_SOLVER_H
+#define PROJECT_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "DataReader.h"
+#include "GameSession.h"
+
+/**
+ *  Searches a world for the shortest way to win it.
+ *  Every command is run through a real GameSession, so the search sees
+ *  exactly the rules a player does. States are explored breadth first,
+ *  a depth at a time, spread over a worker pool. Each state is reduced
+ *  to a 64 bit key to find the states already seen. The order objects
+ *  are listed in doesn't change the key, the random engine does, so
+ *  the magic word is searched soundly.
+ *
+ *  The full state space of a world grows quickly with the number of
+ *  objects, so the states kept at each depth can be limited. The ones
+ *  that have made the most progress (treasures, revealed objects, open
+ *  exits) are kept and the result is no longer guaranteed shortest, or
+ *  a world that can't be won proven so.
+ */
+class Solver
+{
+ public:
+  struct Options
+  {
+    unsigned int num_workers = 0; /**< 0 for one per core. */
+    size_t frontier_limit = 0;    /**< States kept per depth, 0 for all. */
+    int max_depth = 1000;         /**< Commands to search to. */
+    uint32_t seed = 1;            /**< Seeds the session, e.g. for SAY. */
+    bool stop_at_win = true;      /**< False to explore every state. */
+  };
+
+  struct Result
+  {
+    bool completable = false;
+    /** False if the frontier was ever cut or the depth limit was hit. */
+    bool exhaustive = true;
+    int depth = 0;          /**< Depth the search reached. */
+
+    std::vector<std::string> solution; /**< Commands that win the game. */
+
+    /** Treasures never carried in any state, by object index. */
+    std::vector<int> unreached_treasures;
+
+    /** States the game can't be won from, see Solver::solve(). */
+    uint64_t dead_ends = 0;
+    std::vector<std::string> dead_end_path; /**< Reaches the first one. */
+
+    uint64_t states = 0;       /**< Distinct states seen. */
+    uint64_t commands_run = 0; /**< Commands run through the session. */
+  };
+
+  explicit Solver(DATA::FileReader reader);
+  ~Solver() = default;
+
+  bool load();
+  Result solve(const Options& options);
+  const std::vector<std::string>& commands() const;
+
+ private:
+  struct Node
+  {
+    int parent;  /**< Index of the state one depth up. */
+    int command; /**< Command that led here from the parent. */
+  };
+
+  void buildCommands();
+  std::vector<std::string> pathTo(const std::vector<std::vector<Node>>& levels,
+                                  int depth,
+                                  int index) const;
+
+  GameSession prototype;
+  std::vector<std::string> command_list;
+};
+
+#endif // PROJECT_SOLVER_H
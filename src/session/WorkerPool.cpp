@@ -0,0 +1,192 @@
+//
+// Created by Zoe on 05/11/2019.
+//
+
+#include "WorkerPool.h"
+#include <chrono>
+
+namespace
+{
+thread_local int current_worker = -1;
+}
+
+WorkerPool::WorkerPool(unsigned int num_workers)
+{
+  if (num_workers == 0)
+  {
+    num_workers = 1;
+  }
+
+  for (unsigned int i = 0; i < num_workers; i++)
+  {
+    workers.emplace_back(new Worker());
+  }
+
+  for (unsigned int i = 0; i < num_workers; i++)
+  {
+    workers[i]->thread = std::thread(&WorkerPool::run, this, i);
+  }
+}
+
+/**
+ *   @brief   Destructor.
+ *   @details Runs any tasks still queued, then joins the workers.
+ */
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+
+  for (auto& worker : workers)
+  {
+    worker->thread.join();
+  }
+}
+
+/**
+ *   @brief   Queues a task
+ *   @details Tasks submitted from a worker go to the back of that
+ *            worker's own deque, other tasks are dealt out round robin.
+ *   @param   task The task to run.
+ */
+void WorkerPool::submit(Task task)
+{
+  unsigned int index = current_worker >= 0
+                         ? static_cast<unsigned int>(current_worker)
+                         : next_worker++ % size();
+
+  {
+    std::lock_guard<std::mutex> lock(workers[index]->mutex);
+    workers[index]->tasks.push_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    queued += 1;
+  }
+  wake.notify_one();
+}
+
+/**
+ *   @brief   Runs a task a number of times and waits for them all
+ *   @details Must not be called from one of the pool's own workers.
+ *   @param   count The number of times to run the task.
+ *   @param   task Called with each index from 0 to count.
+ */
+void WorkerPool::runAll(unsigned int count,
+                        const std::function<void(unsigned int)>& task)
+{
+  std::mutex mutex;
+  std::condition_variable done;
+  unsigned int remaining = count;
+
+  for (unsigned int i = 0; i < count; i++)
+  {
+    submit([&, i] {
+      task(i);
+      std::lock_guard<std::mutex> lock(mutex);
+      remaining -= 1;
+      done.notify_all();
+    });
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [&remaining] { return remaining == 0; });
+}
+
+unsigned int WorkerPool::size() const
+{
+  return static_cast<unsigned int>(workers.size());
+}
+
+std::vector<WorkerPool::WorkerStats> WorkerPool::stats() const
+{
+  std::vector<WorkerStats> result(workers.size());
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    result[i].tasks = workers[i]->tasks_run;
+    result[i].steals = workers[i]->steals;
+    result[i].busy_seconds = static_cast<double>(workers[i]->busy_ns) / 1e9;
+  }
+  return result;
+}
+
+/**
+ *   @brief   The index of the worker running the calling thread
+ *   @return  The worker index, or -1 if not called from a worker.
+ */
+int WorkerPool::currentWorker()
+{
+  return current_worker;
+}
+
+void WorkerPool::run(unsigned int index)
+{
+  current_worker = static_cast<int>(index);
+  Worker& worker = *workers[index];
+
+  while (true)
+  {
+    Task task;
+    if (popTask(index, &task) || stealTask(index, &task))
+    {
+      {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        queued -= 1;
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      task();
+      auto end = std::chrono::steady_clock::now();
+
+      worker.tasks_run += 1;
+      worker.busy_ns += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count());
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    wake.wait(lock, [this] { return stopping || queued > 0; });
+    if (stopping && queued == 0)
+    {
+      break;
+    }
+  }
+}
+
+bool WorkerPool::popTask(unsigned int index, Task* task)
+{
+  Worker& worker = *workers[index];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (worker.tasks.empty())
+  {
+    return false;
+  }
+
+  *task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+bool WorkerPool::stealTask(unsigned int index, Task* task)
+{
+  for (unsigned int i = 1; i < size(); i++)
+  {
+    Worker& victim = *workers[(index + i) % size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.tasks.empty())
+    {
+      continue;
+    }
+
+    *task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    workers[index]->steals += 1;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,76 @@
+//
+// Created by Zoe on 05/11/2019.
+//
+
+#ifndef PROJECT_WORKERPOOL_H
+#define PROJECT_WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ *  A fixed size, work-stealing thread pool.
+ *  Every worker owns a task deque. Workers pop their own newest task
+ *  first and steal the oldest task from another worker when their own
+ *  deque is empty, so busy workers keep their caches warm and idle
+ *  workers pick up the slack.
+ */
+class WorkerPool
+{
+ public:
+  using Task = std::function<void()>;
+
+  struct WorkerStats
+  {
+    uint64_t tasks = 0;  /**< Tasks run by the worker. */
+    uint64_t steals = 0; /**< Tasks taken from another worker. */
+    double busy_seconds = 0;
+  };
+
+  explicit WorkerPool(unsigned int num_workers);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  void submit(Task task);
+  void runAll(unsigned int count,
+              const std::function<void(unsigned int)>& task);
+  unsigned int size() const;
+  std::vector<WorkerStats> stats() const;
+
+  static int currentWorker();
+
+ private:
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::thread thread;
+
+    std::atomic<uint64_t> tasks_run{ 0 };
+    std::atomic<uint64_t> steals{ 0 };
+    std::atomic<uint64_t> busy_ns{ 0 };
+  };
+
+  void run(unsigned int index);
+  bool popTask(unsigned int index, Task* task);
+  bool stealTask(unsigned int index, Task* task);
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::atomic<unsigned int> next_worker{ 0 };
+
+  std::mutex sleep_mutex; /**< Guards queued and stopping. */
+  std::condition_variable wake;
+  int queued = 0; /**< Tasks submitted but not yet taken. */
+  bool stopping = false;
+};
+
+#endif // PROJECT_WORKERPOOL_H
@@ -0,0 +1,256 @@
+//
+// Created by Zoe on 18/11/2019.
+//
+
+#include "WorldWatcher.h"
+#include "DataReader.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#  include <poll.h>
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+const char* const WORLD_FILES[] = { "rooms.json",
+                                    "objects.json",
+                                    "actions.json" };
+
+// how long the thread waits before checking whether it should stop
+const int WAKE_MS = 200;
+
+// editors write a file in several steps, changes this close together
+// are loaded as one
+const int SETTLE_MS = 50;
+
+bool isWorldFile(const std::string& file_name)
+{
+  return std::find(std::begin(WORLD_FILES),
+                   std::end(WORLD_FILES),
+                   file_name) != std::end(WORLD_FILES);
+}
+
+#ifndef __linux__
+std::time_t modifiedTime(const std::string& path)
+{
+  struct stat info = {};
+  if (stat(path.c_str(), &info) != 0)
+  {
+    return -1;
+  }
+  return info.st_mtime;
+}
+#endif
+}
+
+/**
+ *   @param   directory The folder holding the JSON files.
+ *   @param   world_data The world loaded from them.
+ *   @param   handler Called with every new world.
+ */
+WorldWatcher::WorldWatcher(std::string directory,
+                           std::shared_ptr<const WorldData> world_data,
+                           Handler handler) :
+  folder(std::move(directory)),
+  on_reload(std::move(handler)), current_world(std::move(world_data))
+{
+}
+
+WorldWatcher::~WorldWatcher()
+{
+  stop();
+}
+
+/**
+ *   @brief   Starts watching the folder
+ *   @return  False if the folder couldn't be watched.
+ */
+bool WorldWatcher::start()
+{
+  if (thread.joinable())
+  {
+    return true;
+  }
+
+#ifdef __linux__
+  watch_handle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watch_handle == -1 ||
+      inotify_add_watch(
+        watch_handle, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+  {
+    std::cout << "Can't watch " << folder << std::endl;
+    if (watch_handle != -1)
+    {
+      close(watch_handle);
+      watch_handle = -1;
+    }
+    return false;
+  }
+#else
+  file_times.clear();
+  for (const char* file_name : WORLD_FILES)
+  {
+    file_times.push_back(modifiedTime(folder + "/" + file_name));
+  }
+#endif
+
+  stopping = false;
+  thread = std::thread(&WorldWatcher::run, this);
+  return true;
+}
+
+/**
+ *   @brief   Stops watching, waits for a reload in progress to finish
+ */
+void WorldWatcher::stop()
+{
+  stopping = true;
+  if (thread.joinable())
+  {
+    thread.join();
+  }
+
+#ifdef __linux__
+  if (watch_handle != -1)
+  {
+    close(watch_handle);
+    watch_handle = -1;
+  }
+#endif
+}
+
+/**
+ *   @brief   Reloads some of the files now
+ *   @details Called by the watcher's thread, can also be called
+ *            directly. Every file is loaded into one copy of the
+ *            world, which replaces the world only if all of them
+ *            loaded and it can still be played.
+ *   @param   file_names The files that changed, e.g. "rooms.json".
+ *   @return  True if the world was replaced.
+ */
+bool WorldWatcher::reload(const std::vector<std::string>& file_names)
+{
+  auto started = std::chrono::steady_clock::now();
+  auto world_data = std::make_shared<WorldData>(*world());
+
+  DATA::FileReader read_file = DATA::diskReader(folder);
+  for (const auto& file_name : file_names)
+  {
+    if (!world_data->reload(read_file, file_name))
+    {
+      std::cout << "Kept the world, " << file_name << " didn't load"
+                << std::endl;
+      failure_count += 1;
+      return false;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(world_mutex);
+    current_world = world_data;
+  }
+  reload_count += 1;
+
+  std::chrono::duration<double, std::milli> took =
+    std::chrono::steady_clock::now() - started;
+  std::cout << "Reloaded the world in " << took.count() << "ms" << std::endl;
+
+  if (on_reload)
+  {
+    on_reload(world_data);
+  }
+  return true;
+}
+
+/**
+ *   @brief   The newest world that loaded
+ */
+std::shared_ptr<const WorldData> WorldWatcher::world()
+{
+  std::lock_guard<std::mutex> lock(world_mutex);
+  return current_world;
+}
+
+int WorldWatcher::reloads() const
+{
+  return reload_count;
+}
+
+int WorldWatcher::failures() const
+{
+  return failure_count;
+}
+
+void WorldWatcher::run()
+{
+  std::vector<std::string> file_names;
+  while (!stopping)
+  {
+    file_names.clear();
+    if (waitForChanges(&file_names))
+    {
+      reload(file_names);
+    }
+  }
+}
+
+#ifdef __linux__
+/**
+ *   @brief   Waits a short while for the world's files to change
+ *   @param   file_names Set to the files that changed, each once.
+ *   @return  True if any changed.
+ */
+bool WorldWatcher::waitForChanges(std::vector<std::string>* file_names)
+{
+  pollfd watch = { watch_handle, POLLIN, 0 };
+  int timeout = WAKE_MS;
+  while (poll(&watch, 1, timeout) > 0)
+  {
+    alignas(inotify_event) char events[4096];
+    ssize_t length = 0;
+    while ((length = read(watch_handle, events, sizeof(events))) > 0)
+    {
+      for (ssize_t i = 0; i < length;)
+      {
+        const auto* event = reinterpret_cast<const inotify_event*>(events + i);
+        std::string file_name = event->len != 0 ? event->name : "";
+        if (isWorldFile(file_name) &&
+            std::find(file_names->begin(), file_names->end(), file_name) ==
+              file_names->end())
+        {
+          file_names->push_back(file_name);
+        }
+        i += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+      }
+    }
+    timeout = SETTLE_MS;
+  }
+  return !file_names->empty();
+}
+#else
+/**
+ *   @brief   Waits a short while for the world's files to change
+ *   @param   file_names Set to the files that changed, each once.
+ *   @return  True if any changed.
+ */
+bool WorldWatcher::waitForChanges(std::vector<std::string>* file_names)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(WAKE_MS));
+  for (size_t i = 0; i < file_times.size(); i++)
+  {
+    std::time_t modified = modifiedTime(folder + "/" + WORLD_FILES[i]);
+    if (modified != file_times[i])
+    {
+      file_times[i] = modified;
+      file_names->push_back(WORLD_FILES[i]);
+    }
+  }
+  return !file_names->empty();
+}
+#endif
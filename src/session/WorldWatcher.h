@@ -0,0 +1,70 @@
+//
+// Created by Zoe on 18/11/2019.
+//
+
+#ifndef PROJECT_WORLDWATCHER_H
+#define PROJECT_WORLDWATCHER_H
+
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../map/WorldData.h"
+
+/**
+ *  Reloads the world when its JSON files change on disk.
+ *  Runs on its own thread. Only the files that changed are parsed
+ *  again, into a copy of the world, and the copy is checked before it
+ *  replaces the world, so sessions never see a half loaded or broken
+ *  world. A damaged file is reported and the old world kept until the
+ *  file is fixed. The handler is called from the watcher's thread with
+ *  every new world, e.g. to pass it to SessionHost::reloadWorld().
+ *  On Linux the folder is watched with inotify, elsewhere the files
+ *  are polled.
+ */
+class WorldWatcher
+{
+ public:
+  using Handler = std::function<void(std::shared_ptr<const WorldData>)>;
+
+  WorldWatcher(std::string directory,
+               std::shared_ptr<const WorldData> world_data,
+               Handler handler);
+  ~WorldWatcher();
+
+  WorldWatcher(const WorldWatcher&) = delete;
+  WorldWatcher& operator=(const WorldWatcher&) = delete;
+
+  bool start();
+  void stop();
+  bool reload(const std::vector<std::string>& file_names);
+
+  std::shared_ptr<const WorldData> world();
+  int reloads() const;
+  int failures() const;
+
+ private:
+  void run();
+  bool waitForChanges(std::vector<std::string>* file_names);
+
+  std::string folder;
+  Handler on_reload;
+
+  std::mutex world_mutex;
+  std::shared_ptr<const WorldData> current_world;
+
+  std::atomic<bool> stopping{ false };
+  std::atomic<int> reload_count{ 0 };
+  std::atomic<int> failure_count{ 0 };
+
+  int watch_handle = -1;               /**< The inotify instance, on Linux. */
+  std::vector<std::time_t> file_times; /**< Modified times, when polling. */
+  std::thread thread;
+};
+
+#endif // PROJECT_WORLDWATCHER_H
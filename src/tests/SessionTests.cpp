@@ -0,0 +1,294 @@
+//
+// Created by Zoe on 26/11/2019.
+//
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "map/WorldData.h"
+#include "session/DataReader.h"
+#include "session/GameSession.h"
+#include "session/Replay.h"
+#include "session/SessionHost.h"
+
+namespace
+{
+// picks up the MATCHES and ROPE with seed 1
+const char* const OPENING[] = { "SAY XZANFAR", "SAY XZANFAR", "SAY XZANFAR",
+                                "N",           "E",           "GET MATCHES",
+                                "SAY XZANFAR", "SAY XZANFAR", "GET ROPE" };
+
+const char* const AFTER_RELOAD[] = { "N", "E", "S", "W", "INVENTORY", "SCORE" };
+
+// sent to the hosted sessions, the magic word moves the player at random
+const char* const HOSTED_COMMANDS[] = { "N",           "E",        "S",
+                                        "W",           "GET ROPE", "INV",
+                                        "SAY XZANFAR", "SCORE",    "XYZZY" };
+const int HOSTED_SESSIONS = 64;
+const int HOSTED_STEPS = 40;
+const unsigned int HOST_WORKERS = 4;
+
+/**
+ *   @brief   The command a hosted session is sent at a step
+ *   @details Differs between sessions, so they don't all play alike.
+ */
+const char* hostedCommand(int session, int turn)
+{
+  const size_t count = sizeof(HOSTED_COMMANDS) / sizeof(HOSTED_COMMANDS[0]);
+  return HOSTED_COMMANDS[static_cast<size_t>(session * 7 + turn * turn) %
+                         count];
+}
+
+/**
+ *   @brief   A world like the prototype's, with rooms.json read again
+ */
+std::shared_ptr<const WorldData> reloadedWorld(const GameSession& prototype)
+{
+  auto world_data = std::make_shared<WorldData>(prototype.worldData());
+  if (!world_data->reload(DATA::diskReader(GAMEDATA_PATH), "rooms.json"))
+  {
+    return nullptr;
+  }
+  return world_data;
+}
+
+/**
+ *   @brief   Runs a command and adds it to a transcript
+ *   @details In the same form as REPLAY::transcript().
+ */
+void step(GameSession* session, const std::string& command, std::string* text)
+{
+  *text += "> ";
+  *text += command;
+  *text += '\n';
+  *text += session->step(command);
+  *text += '\n';
+}
+
+/**
+ *   @brief   A log recorded across a reload plays back the same game
+ *   @details The log restarts at the reload, so it has to start from
+ *            the game as it was carried into the new world.
+ */
+bool replayAcrossReload(const GameSession& prototype)
+{
+  GameSession session = prototype;
+  session.recordLog(100);
+  session.seed(1);
+  session.reset();
+  for (const char* command : OPENING)
+  {
+    session.step(command);
+  }
+
+  auto world_data = reloadedWorld(session);
+  if (!world_data)
+  {
+    std::cout << "  could not reload rooms.json\n";
+    return false;
+  }
+  session.reload(world_data);
+
+  std::string played = session.response() + '\n';
+  for (const char* command : AFTER_RELOAD)
+  {
+    step(&session, command, &played);
+  }
+
+  GameSession replayer = prototype;
+  replayer.reload(world_data);
+  std::string replayed;
+  if (!REPLAY::transcript(replayer, session.log(), &replayed))
+  {
+    std::cout << "  the log's save didn't load\n";
+    return false;
+  }
+  if (replayed != played)
+  {
+    std::cout << "  played:\n" << played << "  replayed:\n" << replayed;
+    return false;
+  }
+  return true;
+}
+
+/**
+ *   @brief   Objects in no room's list keep no links after a reload
+ */
+bool reloadUnlinksCarried(const GameSession& prototype)
+{
+  GameSession session = prototype;
+  session.seed(1);
+  session.reset();
+  for (const char* command : OPENING)
+  {
+    session.step(command);
+  }
+  // it shares a room with the BOOKS, so it had links before
+  session.step("SAY XZANFAR");
+  session.step("SAY XZANFAR");
+  if (session.step("GET CANDLESTICK") != "You picked up CANDLESTICK")
+  {
+    std::cout << "  the CANDLESTICK wasn't picked up\n";
+    return false;
+  }
+
+  auto world_data = reloadedWorld(session);
+  if (!world_data)
+  {
+    std::cout << "  could not reload rooms.json\n";
+    return false;
+  }
+  session.reload(world_data);
+
+  const SessionState& state = session.snapshot();
+  for (size_t i = 0; i < state.object_location.size(); i++)
+  {
+    if (state.object_location[i] < 0 &&
+        (state.object_next[i] != -1 || state.object_prev[i] != -1))
+    {
+      std::cout << "  object " << i << " is still linked\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ *   @brief   Asking if commands are accepted leaves the session as it was
+ */
+bool acceptsChangesNothing(const GameSession& prototype)
+{
+  GameSession session = prototype;
+  const std::string response = session.step("N");
+  const char* const probes[] = { "XYZZY", "SAY HELLO", "UNDO 3", "GET ROPE" };
+  for (const char* probe : probes)
+  {
+    session.accepts(probe);
+  }
+  if (session.response() != response)
+  {
+    std::cout << "  the response changed to: " << session.response() << "\n";
+    return false;
+  }
+  return true;
+}
+
+/**
+ *   @brief   Sessions run on the host play as if run one at a time
+ *   @details Each hosted session's responses are compared with a
+ *            session stepped on this thread from the same state,
+ *            across a reload of the world half way through.
+ */
+bool hostMatchesSerial(const GameSession& prototype)
+{
+  SessionHost host(DATA::diskReader(GAMEDATA_PATH), HOST_WORKERS);
+  if (!host.load())
+  {
+    std::cout << "  the host could not load the game data\n";
+    return false;
+  }
+
+  std::vector<std::string> hosted(HOSTED_SESSIONS);
+  host.onResponse([&hosted](int session,
+                            const std::string& command,
+                            const std::string& response) {
+    std::string& text = hosted[static_cast<size_t>(session)];
+    text += "> " + command + '\n' + response + '\n';
+  });
+
+  std::vector<SessionState> starts;
+  for (int i = 0; i < HOSTED_SESSIONS; i++)
+  {
+    starts.push_back(host.session(host.createSession()).snapshot());
+  }
+
+  auto world_data = reloadedWorld(prototype);
+  if (!world_data)
+  {
+    std::cout << "  could not reload rooms.json\n";
+    return false;
+  }
+  for (int half = 0; half < 2; half++)
+  {
+    if (half == 1)
+    {
+      host.reloadWorld(world_data);
+    }
+    for (int turn = half * HOSTED_STEPS / 2;
+         turn < (half + 1) * HOSTED_STEPS / 2;
+         turn++)
+    {
+      for (int i = 0; i < HOSTED_SESSIONS; i++)
+      {
+        host.submit(i, hostedCommand(i, turn));
+      }
+    }
+    host.wait();
+  }
+
+  for (int i = 0; i < HOSTED_SESSIONS; i++)
+  {
+    GameSession session = prototype;
+    session.restore(starts[static_cast<size_t>(i)]);
+    std::string serial;
+    for (int turn = 0; turn < HOSTED_STEPS; turn++)
+    {
+      if (turn == HOSTED_STEPS / 2)
+      {
+        session.reload(world_data);
+      }
+      step(&session, hostedCommand(i, turn), &serial);
+    }
+    if (&host.session(i).worldData() != world_data.get())
+    {
+      std::cout << "  session " << i << " wasn't moved to the new world\n";
+      return false;
+    }
+    if (serial != hosted[static_cast<size_t>(i)])
+    {
+      std::cout << "  session " << i << " differs\n  hosted:\n"
+                << hosted[static_cast<size_t>(i)] << "  serial:\n"
+                << serial;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+/**
+ *   @brief   Checks the game core on the built game data
+ *   @details Exits with 1 if any test fails.
+ */
+int main()
+{
+  GameSession prototype(DATA::diskReader(GAMEDATA_PATH));
+  if (!prototype.load())
+  {
+    std::cerr << "could not load the game data in " << GAMEDATA_PATH
+              << std::endl;
+    return 1;
+  }
+  prototype.reset();
+
+  struct Test
+  {
+    const char* name;
+    bool (*run)(const GameSession&);
+  };
+  const Test tests[] = { { "replayAcrossReload", replayAcrossReload },
+                         { "reloadUnlinksCarried", reloadUnlinksCarried },
+                         { "acceptsChangesNothing", acceptsChangesNothing },
+                         { "hostMatchesSerial", hostMatchesSerial } };
+
+  int failed = 0;
+  for (const Test& test : tests)
+  {
+    bool passed = test.run(prototype);
+    std::cout << (passed ? "OK    " : "FAIL  ") << test.name << "\n";
+    failed += passed ? 0 : 1;
+  }
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+//
+// Created by Zoe on 22/11/2019.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace
+{
+// a benchmark slower than the baseline by more than this is reported
+const double DEFAULT_THRESHOLD = 10.0;
+
+struct Timing
+{
+  double total_ns = 0;
+  int runs = 0;
+  bool median = false;
+
+  double ns() const
+  {
+    return runs == 0 ? 0 : total_ns / runs;
+  }
+};
+
+using Timings = std::map<std::string, Timing>;
+
+void usage(const char* program)
+{
+  std::cerr << "usage: " << program
+            << " <baseline.json> <contender.json> [--threshold percent]"
+            << std::endl;
+}
+
+double toNanoseconds(double time, const std::string& unit)
+{
+  if (unit == "us")
+  {
+    return time * 1e3;
+  }
+  if (unit == "ms")
+  {
+    return time * 1e6;
+  }
+  return unit == "s" ? time * 1e9 : time;
+}
+
+/**
+ *   @brief   Reads the CPU time of each benchmark from a results file
+ *   @details The median is used when the run was repeated, otherwise
+ *            the mean of its runs. Benchmarks that failed are left out.
+ */
+bool readResults(const std::string& path, Timings* timings)
+{
+  std::ifstream file(path);
+  if (!file)
+  {
+    std::cerr << "could not read " << path << std::endl;
+    return false;
+  }
+
+  nlohmann::json results = nlohmann::json::parse(file, nullptr, false);
+  if (results.is_discarded() || !results.is_object() ||
+      !results["benchmarks"].is_array())
+  {
+    std::cerr << path << " is not a benchmark results file" << std::endl;
+    return false;
+  }
+
+  for (const auto& benchmark : results["benchmarks"])
+  {
+    if (benchmark.value("error_occurred", false))
+    {
+      continue;
+    }
+    const std::string run_type = benchmark.value("run_type", "iteration");
+    const std::string aggregate = benchmark.value("aggregate_name", "");
+    if (run_type == "aggregate" && aggregate != "median")
+    {
+      continue;
+    }
+
+    const double ns =
+      toNanoseconds(benchmark.value("cpu_time", 0.0),
+                    benchmark.value("time_unit", std::string("ns")));
+    Timing& timing =
+      (*timings)[benchmark.value("run_name", benchmark.value("name", ""))];
+    if (aggregate == "median")
+    {
+      timing = Timing{ ns, 1, true };
+    }
+    else if (!timing.median)
+    {
+      timing.total_ns += ns;
+      timing.runs += 1;
+    }
+  }
+  return true;
+}
+}
+
+/**
+ *   @brief   Compares two runs of the benchmarks
+ *   @details Usage: BenchCompare <baseline.json> <contender.json>
+ *            [--threshold percent]. The files are written by the
+ *            RunBenchmarks target, or by BasicReb0rnBench with
+ *            --benchmark_out. Prints the change in CPU time of every
+ *            benchmark in both files, and exits with 1 if any got
+ *            slower by more than the threshold, 10% by default.
+ */
+int main(int argc, char* argv[])
+{
+  if (argc != 3 && argc != 5)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  double threshold = DEFAULT_THRESHOLD;
+  if (argc == 5)
+  {
+    if (std::string(argv[3]) != "--threshold")
+    {
+      usage(argv[0]);
+      return 1;
+    }
+    threshold = std::strtod(argv[4], nullptr);
+  }
+
+  Timings baseline;
+  Timings contender;
+  if (!readResults(argv[1], &baseline) || !readResults(argv[2], &contender))
+  {
+    return 1;
+  }
+
+  int compared = 0;
+  int regressions = 0;
+  for (const auto& entry : baseline)
+  {
+    auto found = contender.find(entry.first);
+    if (found == contender.end() || entry.second.ns() <= 0)
+    {
+      continue;
+    }
+
+    const double before = entry.second.ns();
+    const double after = found->second.ns();
+    const double change = (after - before) / before * 100.0;
+    const bool regressed = change > threshold;
+    std::printf("%-48s %14.1f ns %14.1f ns %+8.1f%%%s\n",
+                entry.first.c_str(),
+                before,
+                after,
+                change,
+                regressed ? "  SLOWER" : "");
+    compared += 1;
+    regressions += regressed ? 1 : 0;
+  }
+
+  std::cout << compared << " benchmarks compared, " << regressions
+            << " slower by more than " << threshold << "%" << std::endl;
+  return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+//
+// Created by Zoe on 15/11/2019.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "session/DataReader.h"
+#include "session/GameSession.h"
+#include "session/Replay.h"
+#include "session/WorkerPool.h"
+
+namespace
+{
+const char* const TRANSCRIPT_EXTENSION = ".transcript";
+
+struct Job
+{
+  std::string path;
+  bool read = false;
+  bool expected_found = false;
+  REPLAY::Log log;
+  std::string actual;
+  std::string expected;
+};
+
+void usage(const char* program)
+{
+  std::cerr << "usage: " << program << " <game data folder> <log files...>"
+            << " [--workers n] [--update]" << std::endl;
+}
+
+bool readFile(const std::string& path, std::string* contents)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  std::ostringstream buffer;
+  buffer << file.rdbuf();
+  *contents = buffer.str();
+  return true;
+}
+
+std::string transcriptPath(const std::string& log_path)
+{
+  return log_path + TRANSCRIPT_EXTENSION;
+}
+
+/**
+ *   @brief   Prints where two transcripts first differ
+ */
+void printDiff(const std::string& expected, const std::string& actual)
+{
+  std::istringstream expected_lines(expected);
+  std::istringstream actual_lines(actual);
+  std::string expected_line;
+  std::string actual_line;
+  for (int line = 1;; line++)
+  {
+    bool more_expected =
+      static_cast<bool>(std::getline(expected_lines, expected_line));
+    bool more_actual =
+      static_cast<bool>(std::getline(actual_lines, actual_line));
+    if (!more_expected && !more_actual)
+    {
+      return;
+    }
+    if (more_expected != more_actual || expected_line != actual_line)
+    {
+      std::cout << "  line " << line << "\n"
+                << "  expected: "
+                << (more_expected ? expected_line : "<end>") << "\n"
+                << "  actual:   " << (more_actual ? actual_line : "<end>")
+                << "\n";
+      return;
+    }
+  }
+}
+}
+
+/**
+ *   @brief   Plays recorded games back and checks nothing has changed
+ *   @details Usage: ReplayRunner <game data folder> <log files...>.
+ *            Each log is played back on its own worker and compared to
+ *            the transcript saved next to it. --update saves the new
+ *            transcripts instead. Exits with 1 if any transcript
+ *            differs, or a log or the save it starts from can't be
+ *            read.
+ */
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  unsigned int num_workers = 0;
+  bool update = false;
+  std::vector<Job> jobs;
+  for (int i = 2; i < argc; i++)
+  {
+    std::string option = argv[i];
+    if (option == "--workers" && i + 1 < argc)
+    {
+      num_workers =
+        static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (option == "--update")
+    {
+      update = true;
+    }
+    else if (option.compare(0, 2, "--") == 0)
+    {
+      usage(argv[0]);
+      return 1;
+    }
+    else
+    {
+      jobs.emplace_back();
+      jobs.back().path = option;
+    }
+  }
+
+  GameSession prototype(DATA::diskReader(argv[1]));
+  if (!prototype.load())
+  {
+    std::cerr << "could not load the game data in " << argv[1] << std::endl;
+    return 1;
+  }
+
+  // everything is read up front so the workers only play games
+  size_t command_count = 0;
+  for (Job& job : jobs)
+  {
+    std::string text;
+    job.read = readFile(job.path, &text) &&
+               REPLAY::parse(text.data(), text.size(), &job.log);
+    job.expected_found = readFile(transcriptPath(job.path), &job.expected);
+    command_count += job.log.commands.size();
+  }
+
+  if (num_workers == 0)
+  {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    WorkerPool pool(num_workers);
+    pool.runAll(static_cast<unsigned int>(jobs.size()), [&](unsigned int i) {
+      if (jobs[i].read)
+      {
+        jobs[i].read =
+          REPLAY::transcript(prototype, jobs[i].log, &jobs[i].actual);
+      }
+    });
+  }
+  std::chrono::duration<double> seconds =
+    std::chrono::steady_clock::now() - start;
+
+  int failed = 0;
+  for (const Job& job : jobs)
+  {
+    if (!job.read)
+    {
+      std::cout << "BAD   " << job.path << "\n";
+      failed += 1;
+    }
+    else if (update)
+    {
+      std::ofstream file(transcriptPath(job.path),
+                         std::ios::binary | std::ios::trunc);
+      file << job.actual;
+      std::cout << "SAVED " << job.path << "\n";
+    }
+    else if (!job.expected_found)
+    {
+      std::cout << "NEW   " << job.path << "\n";
+    }
+    else if (job.expected != job.actual)
+    {
+      std::cout << "DIFF  " << job.path << "\n";
+      printDiff(job.expected, job.actual);
+      failed += 1;
+    }
+    else
+    {
+      std::cout << "OK    " << job.path << "\n";
+    }
+  }
+
+  std::cout << jobs.size() << " logs, " << command_count << " commands in "
+            << seconds.count() << "s ("
+            << static_cast<double>(command_count) / seconds.count()
+            << " commands/s), " << failed << " failed" << std::endl;
+  return failed == 0 ? 0 : 1;
+}
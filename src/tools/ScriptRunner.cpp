@@ -0,0 +1,298 @@
+//
+// Created by Zoe on 20/11/2019.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#  include <io.h>
+#else
+#  include <dirent.h>
+#endif
+
+#include "session/DataReader.h"
+#include "session/GameSession.h"
+#include "session/Replay.h"
+#include "session/WorkerPool.h"
+
+namespace
+{
+const char* const TRANSCRIPT_EXTENSION = ".transcript";
+const char* const SUMMARY_NAME = "summary.csv";
+
+struct Result
+{
+  bool ran = false;
+  size_t commands = 0;
+  int score = 0;
+  int rooms_visited = 0;
+  bool game_over = false;
+  double seconds = 0;
+};
+
+void usage(const char* program)
+{
+  std::cerr << "usage: " << program
+            << " <game data folder> <script folder> <output folder>"
+            << " [--workers n] [--seed n]" << std::endl;
+}
+
+bool readFile(const std::string& path, std::string* contents)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  std::ostringstream buffer;
+  buffer << file.rdbuf();
+  *contents = buffer.str();
+  return true;
+}
+
+/**
+ *   @brief   The names of the files in a folder, sorted
+ */
+std::vector<std::string> listFolder(const std::string& folder)
+{
+  std::vector<std::string> names;
+#ifdef _WIN32
+  _finddata_t found = {};
+  intptr_t search = _findfirst((folder + "/*").c_str(), &found);
+  if (search != -1)
+  {
+    do
+    {
+      if ((found.attrib & _A_SUBDIR) == 0)
+      {
+        names.emplace_back(found.name);
+      }
+    } while (_findnext(search, &found) == 0);
+    _findclose(search);
+  }
+#else
+  if (DIR* directory = opendir(folder.c_str()))
+  {
+    while (dirent* entry = readdir(directory))
+    {
+      if (entry->d_name[0] != '.')
+      {
+        names.emplace_back(entry->d_name);
+      }
+    }
+    closedir(directory);
+  }
+#endif
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+/**
+ *   @brief   Reads a script, one command per line
+ *   @details A script may start with a "SEED n" line, like a session
+ *            log, otherwise it uses the default seed. Blank lines and
+ *            lines starting with '#' are skipped.
+ */
+bool readScript(const std::string& path, uint32_t seed, REPLAY::Log* log)
+{
+  std::string text;
+  if (!readFile(path, &text))
+  {
+    return false;
+  }
+  if (!REPLAY::parse(text.data(), text.size(), log))
+  {
+    text = REPLAY::format(REPLAY::Log{ seed, {}, {} }) + text;
+    REPLAY::parse(text.data(), text.size(), log);
+  }
+
+  auto& commands = log->commands;
+  commands.erase(std::remove_if(commands.begin(),
+                                commands.end(),
+                                [](const std::string& command) {
+                                  return command.empty() || command[0] == '#';
+                                }),
+                 commands.end());
+  return true;
+}
+
+/**
+ *   @brief   Plays a script and writes its transcript
+ *   @details The transcript is written the same way as REPLAY's, so
+ *            the two can be compared. Nothing is run if the script's
+ *            save can't be loaded.
+ */
+Result runScript(const GameSession& prototype,
+                 const REPLAY::Log& log,
+                 const std::string& transcript_path)
+{
+  auto start = std::chrono::steady_clock::now();
+  GameSession session = prototype;
+  if (!REPLAY::start(&session, log))
+  {
+    return Result();
+  }
+
+  std::vector<uint8_t> visited(
+    static_cast<size_t>(session.worldData().roomCount()), 0);
+  visited[static_cast<size_t>(session.snapshot().current_room)] = 1;
+
+  std::string text = session.response();
+  text += '\n';
+  for (const auto& command : log.commands)
+  {
+    text += "> ";
+    text += command;
+    text += '\n';
+    text += session.step(command);
+    text += '\n';
+    visited[static_cast<size_t>(session.snapshot().current_room)] = 1;
+  }
+
+  Result result;
+  std::ofstream file(transcript_path, std::ios::binary | std::ios::trunc);
+  file << text;
+  result.ran = static_cast<bool>(file);
+  result.commands = log.commands.size();
+  result.score = session.playerScore();
+  result.rooms_visited =
+    static_cast<int>(std::count(visited.begin(), visited.end(), 1));
+  result.game_over = session.gameOver();
+
+  std::chrono::duration<double> seconds =
+    std::chrono::steady_clock::now() - start;
+  result.seconds = seconds.count();
+  return result;
+}
+}
+
+/**
+ *   @brief   Plays every script in a folder as its own game
+ *   @details Usage: ScriptRunner <game data folder> <script folder>
+ *            <output folder>. The scripts are shared out between the
+ *            workers, and each one's transcript is written to the
+ *            output folder as it finishes, with a summary.csv of the
+ *            final score, the rooms visited and the commands per
+ *            second of every script. Exits with 1 if any script
+ *            couldn't be read or its transcript written.
+ */
+int main(int argc, char* argv[])
+{
+  if (argc < 4)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  const std::string script_folder = argv[2];
+  const std::string output_folder = argv[3];
+  unsigned int num_workers = 0;
+  uint32_t seed = 0;
+  for (int i = 4; i < argc; i++)
+  {
+    std::string option = argv[i];
+    if (option == "--workers" && i + 1 < argc)
+    {
+      num_workers =
+        static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (option == "--seed" && i + 1 < argc)
+    {
+      seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else
+    {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  GameSession prototype(DATA::diskReader(argv[1]));
+  if (!prototype.load())
+  {
+    std::cerr << "could not load the game data in " << argv[1] << std::endl;
+    return 1;
+  }
+
+  const std::vector<std::string> scripts = listFolder(script_folder);
+  if (scripts.empty())
+  {
+    std::cerr << "no scripts in " << script_folder << std::endl;
+    return 1;
+  }
+
+  if (num_workers == 0)
+  {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // each worker reads its scripts and writes their transcripts itself,
+  // so only the results are kept
+  std::vector<Result> results(scripts.size());
+  auto start = std::chrono::steady_clock::now();
+  {
+    WorkerPool pool(num_workers);
+    pool.runAll(static_cast<unsigned int>(scripts.size()),
+                [&](unsigned int i) {
+                  REPLAY::Log log;
+                  if (readScript(script_folder + "/" + scripts[i], seed, &log))
+                  {
+                    results[i] = runScript(
+                      prototype,
+                      log,
+                      output_folder + "/" + scripts[i] + TRANSCRIPT_EXTENSION);
+                  }
+                });
+  }
+  std::chrono::duration<double> seconds =
+    std::chrono::steady_clock::now() - start;
+
+  std::ofstream summary(output_folder + "/" + SUMMARY_NAME,
+                        std::ios::trunc);
+  summary << "script,commands,score,rooms_visited,game_over,"
+             "commands_per_second\n";
+
+  int failed = 0;
+  size_t command_count = 0;
+  for (size_t i = 0; i < scripts.size(); i++)
+  {
+    const Result& result = results[i];
+    if (!result.ran)
+    {
+      std::cout << "FAILED " << scripts[i] << "\n";
+      failed += 1;
+      continue;
+    }
+
+    command_count += result.commands;
+    summary << scripts[i] << "," << result.commands << "," << result.score
+            << "," << result.rooms_visited << ","
+            << (result.game_over ? 1 : 0) << ","
+            << (result.seconds > 0
+                  ? static_cast<double>(result.commands) / result.seconds
+                  : 0)
+            << "\n";
+  }
+
+  if (!summary)
+  {
+    std::cerr << "could not write the summary to " << output_folder
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << scripts.size() << " scripts, " << command_count
+            << " commands in " << seconds.count() << "s ("
+            << static_cast<double>(command_count) / seconds.count()
+            << " commands/s) on " << num_workers << " workers, " << failed
+            << " failed" << std::endl;
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+//
+// Created by Zoe on 08/11/2019.
+//
+
+#include <iostream>
+#include <string>
+
+#include "map/WorldData.h"
+#include "map/WorldImage.h"
+#include "session/DataReader.h"
+
+/**
+ *   @brief   Compiles the JSON game data into a world image
+ *   @details Usage: WorldCompiler <game data folder> <output file>
+ */
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cerr << "usage: " << argv[0] << " <game data folder> <output file>"
+              << std::endl;
+    return 1;
+  }
+
+  // Always build from the source files, never from an older image
+  auto read_file = DATA::diskReader(argv[1]);
+  WorldData world_data;
+  uint32_t source_hash = 0;
+  if (!world_data.loadSource(read_file) ||
+      !IMAGE::sourceHash(read_file, &source_hash))
+  {
+    std::cerr << "could not load the game data in " << argv[1] << std::endl;
+    return 1;
+  }
+
+  if (!IMAGE::write(world_data, source_hash, argv[2]))
+  {
+    std::cerr << "could not write " << argv[2] << std::endl;
+    return 1;
+  }
+  return 0;
+}
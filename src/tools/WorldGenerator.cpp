@@ -0,0 +1,73 @@
+//
+// Created by Zoe on 13/11/2019.
+//
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "map/RoomGenerator.h"
+#include "map/WorldData.h"
+#include "session/DataReader.h"
+
+namespace
+{
+bool writeFile(const std::string& path, const char* bytes, size_t length)
+{
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(bytes, static_cast<std::streamsize>(length));
+  return static_cast<bool>(file);
+}
+
+bool copyFile(const DATA::FileReader& read_file,
+              const std::string& name,
+              const std::string& output)
+{
+  DATA::FileBuffer buffer;
+  return read_file(name, &buffer) &&
+         writeFile(output + "/" + name, buffer.data(), buffer.size());
+}
+}
+
+/**
+ *   @brief   Generates a world with any number of rooms
+ *   @details Usage: WorldGenerator <game data folder> <output folder>
+ *            <rooms> [seed]. The generated rooms.json is written with
+ *            copies of the game's objects and actions, so the output
+ *            folder can be loaded like the game data folder.
+ */
+int main(int argc, char* argv[])
+{
+  if (argc != 4 && argc != 5)
+  {
+    std::cerr << "usage: " << argv[0]
+              << " <game data folder> <output folder> <rooms> [seed]"
+              << std::endl;
+    return 1;
+  }
+
+  auto read_file = DATA::diskReader(argv[1]);
+  WorldData world_data;
+  if (!world_data.loadSource(read_file))
+  {
+    std::cerr << "could not load the game data in " << argv[1] << std::endl;
+    return 1;
+  }
+
+  const std::string output = argv[2];
+  const int room_count = std::atoi(argv[3]);
+  const auto seed =
+    static_cast<uint32_t>(argc == 5 ? std::strtoul(argv[4], nullptr, 10) : 1);
+
+  std::string rooms =
+    GENERATOR::rooms(room_count, world_data.objectCount(), seed);
+  if (!writeFile(output + "/rooms.json", rooms.data(), rooms.size()) ||
+      !copyFile(read_file, "objects.json", output) ||
+      !copyFile(read_file, "actions.json", output))
+  {
+    std::cerr << "could not write the world to " << output << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,157 @@
+//
+// Created by Zoe on 14/11/2019.
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "session/DataReader.h"
+#include "session/GameSession.h"
+#include "session/Solver.h"
+
+namespace
+{
+void usage(const char* program)
+{
+  std::cerr << "usage: " << program << " <game data folder> [--workers n]"
+            << " [--frontier n] [--depth n] [--seed n] [--explore]"
+            << std::endl;
+}
+
+/**
+ *   @brief   Plays a solution in a new session
+ *   @return  True if it wins the game.
+ */
+bool replay(const DATA::FileReader& read_file,
+            uint32_t seed,
+            const std::vector<std::string>& solution)
+{
+  GameSession session(read_file);
+  session.load();
+  session.seed(seed);
+  session.reset();
+  for (const auto& command : solution)
+  {
+    session.step(command);
+  }
+  return session.gameOver();
+}
+}
+
+/**
+ *   @brief   Checks a world can be won and prints the shortest way
+ *   @details Usage: WorldSolver <game data folder> [options].
+ *            --frontier limits the states kept at each depth, 0 keeps
+ *            them all, which is the only way to search exhaustively.
+ *            --explore carries on after the game is won. Exits with 0
+ *            if the world can be won, 2 if it can't and 3 if no way to
+ *            win was found but the search wasn't exhaustive.
+ */
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  Solver::Options options;
+  options.frontier_limit = 1000;
+  for (int i = 2; i < argc; i++)
+  {
+    std::string option = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (option == "--workers" && has_value)
+    {
+      options.num_workers =
+        static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (option == "--frontier" && has_value)
+    {
+      options.frontier_limit = std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (option == "--depth" && has_value)
+    {
+      options.max_depth = std::atoi(argv[++i]);
+    }
+    else if (option == "--seed" && has_value)
+    {
+      options.seed =
+        static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (option == "--explore")
+    {
+      options.stop_at_win = false;
+    }
+    else
+    {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  auto read_file = DATA::diskReader(argv[1]);
+  Solver solver(read_file);
+  if (!solver.load())
+  {
+    std::cerr << "could not load the game data in " << argv[1] << std::endl;
+    return 1;
+  }
+
+  Solver::Result result = solver.solve(options);
+  std::cout << "states: " << result.states << "\n"
+            << "commands run: " << result.commands_run << "\n"
+            << "depth: " << result.depth << "\n"
+            << "search: "
+            << (result.exhaustive ? "exhaustive"
+                                  : "NOT exhaustive, states were cut at the "
+                                    "frontier limit or depth limit")
+            << "\n"
+            << "dead ends: " << result.dead_ends << "\n";
+
+  if (!result.dead_end_path.empty())
+  {
+    std::cout << "first dead end:";
+    for (const auto& command : result.dead_end_path)
+    {
+      std::cout << " " << command << ",";
+    }
+    std::cout << "\n";
+  }
+
+  for (int treasure : result.unreached_treasures)
+  {
+    std::cout << "treasure never reached: " << treasure + 1 << "\n";
+  }
+
+  if (!result.completable && !result.exhaustive)
+  {
+    std::cout << "no way to win was found, but the search wasn't "
+                 "exhaustive, try --frontier 0"
+              << std::endl;
+    return 3;
+  }
+  if (!result.completable)
+  {
+    std::cout << "no way to win was found" << std::endl;
+    return 2;
+  }
+
+  std::cout << "winning commands (seed " << options.seed << "): "
+            << result.solution.size()
+            << (result.exhaustive ? ", shortest" : "") << "\n";
+  for (const auto& command : result.solution)
+  {
+    std::cout << command << "\n";
+  }
+
+  if (!replay(read_file, options.seed, result.solution))
+  {
+    std::cerr << "the solution did not win when replayed" << std::endl;
+    return 1;
+  }
+  std::cout << "replayed and won" << std::endl;
+  return 0;
+}